@@ -0,0 +1,63 @@
+// GERADO POR Ferramentas/gerador_sintonia.py -- NÃO EDITE À MÃO.
+// Origem: exp5_de/DE_CONV.txt (linha 17, iteração 4, Gbest_Erro 10855.48)
+// Ganhos do treino: Kp=4.91 Ki=1.84 Kd=0.61 a 15.00 ms por amostra
+// (PERIODO_TREINO_MS_SEM_PASSO: log sem a coluna Passo).
+#ifndef SINTONIA_H
+#define SINTONIA_H
+
+#include <EvaNucleo.h>
+
+// Filtro do treino: 1 = KalmanVelocidade com D pela velocidade,
+// 0 = SimpleKalmanFilter com D pela diferença do erro
+// (aqui: simples, de FILTRO_TREINO, log sem anotação)
+#define SINTONIA_FILTRO_VELOCIDADE 0
+
+// Período do laço de controle
+#define PERIODO_CONTROLE_US 5000UL
+
+// Ganhos discretos, já reescalados para PERIODO_CONTROLE_US
+struct Sintonia {
+    static constexpr float kp() { return 4.91f; }
+    static constexpr float ki() { return 0.6133333f; }
+    static constexpr float kd() { return 1.83f; }
+    static constexpr float limiteIntegral() { return 150.0f; }
+};
+
+// (IncertezaMedicao, IncertezaEstimativa, RuidoProcesso)
+struct CoefKalmanSintonia {
+    static constexpr float erroMedicao()    { return 4.0f; }
+    static constexpr float erroEstimativa() { return 2.0f; }
+    static constexpr float ruidoProcesso()  { return 0.3f; }
+    static constexpr float ruidoAceleracao() { return 0.01111111f; }
+};
+
+// cm = 10650.08 * leitura^-0.935 - 10, saturado em [40, 90]
+#define LEITURA_TABELA_MIN 147
+#define LEITURA_TABELA_MAX 310
+const float TABELA_CM[] PROGMEM = {
+    90.0f, 89.5768f, 88.9518f, 88.33487f, 87.72584f, 87.12457f, 86.53091f, 85.9447f,
+    85.36582f, 84.79411f, 84.22946f, 83.67172f, 83.12077f, 82.57648f, 82.03874f, 81.50742f,
+    80.98241f, 80.4636f, 79.95087f, 79.44412f, 78.94324f, 78.44814f, 77.9587f, 77.47483f,
+    76.99645f, 76.52344f, 76.05572f, 75.59321f, 75.13581f, 74.68345f, 74.23603f, 73.79347f,
+    73.3557f, 72.92263f, 72.4942f, 72.07032f, 71.65092f, 71.23594f, 70.8253f, 70.41893f,
+    70.01676f, 69.61874f, 69.22479f, 68.83485f, 68.44887f, 68.06677f, 67.68851f, 67.31402f,
+    66.94325f, 66.57614f, 66.21263f, 65.85268f, 65.49623f, 65.14322f, 64.79362f, 64.44737f,
+    64.10441f, 63.76471f, 63.42822f, 63.09489f, 62.76468f, 62.43753f, 62.11342f, 61.79229f,
+    61.47411f, 61.15884f, 60.84643f, 60.53684f, 60.23004f, 59.92599f, 59.62465f, 59.32598f,
+    59.02996f, 58.73654f, 58.44569f, 58.15737f, 57.87156f, 57.58821f, 57.30731f, 57.02881f,
+    56.75268f, 56.47889f, 56.20742f, 55.93824f, 55.67131f, 55.4066f, 55.1441f, 54.88377f,
+    54.62557f, 54.3695f, 54.11552f, 53.8636f, 53.61373f, 53.36586f, 53.11999f, 52.87609f,
+    52.63412f, 52.39408f, 52.15593f, 51.91966f, 51.68523f, 51.45264f, 51.22185f, 50.99285f,
+    50.76562f, 50.54013f, 50.31637f, 50.09431f, 49.87393f, 49.65523f, 49.43817f, 49.22273f,
+    49.00891f, 48.79668f, 48.58602f, 48.37692f, 48.16935f, 47.96331f, 47.75878f, 47.55573f,
+    47.35415f, 47.15403f, 46.95535f, 46.75809f, 46.56224f, 46.36778f, 46.1747f, 45.98299f,
+    45.79263f, 45.6036f, 45.41589f, 45.22948f, 45.04437f, 44.86054f, 44.67798f, 44.49667f,
+    44.3166f, 44.13775f, 43.96012f, 43.78369f, 43.60846f, 43.43439f, 43.2615f, 43.08976f,
+    42.91916f, 42.74969f, 42.58134f, 42.4141f, 42.24795f, 42.0829f, 41.91891f, 41.756f,
+    41.59413f, 41.43331f, 41.27353f, 41.11477f, 40.95702f, 40.80028f, 40.64453f, 40.48976f,
+    40.33598f, 40.18315f, 40.03129f, 40.0f,
+};
+
+typedef CalibracaoTabela<LEITURA_TABELA_MIN, LEITURA_TABELA_MAX, TABELA_CM> CalibracaoSintonia;
+
+#endif
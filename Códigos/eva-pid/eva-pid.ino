@@ -1,4 +1,8 @@
-#include "Kalman.h"
+#include <EvaNucleo.h>
+#include "Sintonia.h" // Gerado por Ferramentas/gerador_sintonia.py
+
+// Log no Serial custa ~2ms por ciclo. Ligue só para depurar.
+#define EVA_PID_DEBUG 0
 
 // --- PINAGEM DO HARDWARE ---
 const int PIN_ESQ_PWM = 5;
@@ -12,26 +16,31 @@ const int PIN_SENSOR  = A0;
 const int SETPOINT_DISTANCIA = 65;
 const int VELOCIDADE_BASE = 125;                
 
-// --- Inicialização do Filtro de Kalman
-SimpleKalmanFilter filtroDist(4.0, 2.0, 0.3);
+#ifndef SINTONIA_FILTRO_VELOCIDADE
+#error "Sintonia.h sem o filtro do treino: rode de novo o Ferramentas/gerador_sintonia.py"
+#endif
 
-// Variáveis de Controle
-float Kp = 4.91, Ki = 1.84, Kd = 0.61;
-float erroAnterior = 0, integralErro = 0;
+// --- Inicialização do Filtro de Kalman
+// O mesmo filtro (e termo D) com que os ganhos foram treinados
+#if SINTONIA_FILTRO_VELOCIDADE
+KalmanVelocidade<CoefKalmanSintonia> filtroDist;
+#else
+SimpleKalmanFilter<CoefKalmanSintonia> filtroDist;
+#endif
+
+// Variáveis de Controle (ganhos constexpr do Sintonia.h)
+ControlePid<Sintonia> pid;
 float dist = 0, erro = 0, pid_out = 0;
 
 // --- FUNÇÕES AUXILIARES --- 
 float lerDistancia() {
-  int leitura = analogRead(PIN_SENSOR);
+  int leitura = aquisicao.lerMedia(); // Já sobreamostrada pela ISR
   
   // 1. PROTEÇÃO MATEMÁTICA (Do código novo/sugestão anterior)
   if (leitura <= 0) return 90; 
 
-  // Sua equação calibrada
-  float cm = 10650.08 * pow(leitura,-0.935) - 10;
-  
-  if (cm < 40) cm = 40;
-  if (cm > 90) cm = 90;
+  // Sua equação calibrada (tabelada e já saturada em 40..90)
+  float cm = CalibracaoSintonia::cm(leitura);
 
   float cm_filtrado = filtroDist.updateEstimate(cm);
   return cm_filtrado;
@@ -65,6 +74,9 @@ void setup(){
   // Cria o "Terra" virtual para os motores
   digitalWrite(PIN_ESQ_GND, LOW);
   digitalWrite(PIN_DIR_GND, LOW);
+
+  // ADC em modo contínuo no sensor (substitui o analogRead)
+  aquisicao.iniciar(PIN_SENSOR);
   
   Serial.println("EVA PID Simples Iniciado");
 }
@@ -75,26 +87,25 @@ void loop(){
   erro = SETPOINT_DISTANCIA - dist;
 
   // --- CÁLCULO PID ---
-  float P = Kp * erro;
-  
-  integralErro += erro;
-  // Anti-windup
-  if(integralErro > 50) integralErro = 50; 
-  if(integralErro < -50) integralErro = -50;
-  
-  float I = Ki * integralErro;
-  float D = Kd * (erro - erroAnterior);
-  
-  erroAnterior = erro;
-  pid_out = P + I + D;
-
+#if SINTONIA_FILTRO_VELOCIDADE
+  // D usa a velocidade do filtro: d(erro)/dt = -d(dist)/dt
+  pid_out = pid.calcular(erro, -filtroDist.getVelocidade());
+#else
+  pid_out = pid.calcular(erro); // D pela diferença do erro, como no treino
+#endif
+
+#if EVA_PID_DEBUG
   // Debug limpo
   Serial.print("Dist: ");
   Serial.print(dist);
   Serial.print(" | PID: ");
   Serial.println(pid_out);
+#endif
 
   acionarMotores(pid_out);
   
-  delay(10); // Estabilidade do loop
+  // Período fixo: os ganhos do Sintonia.h foram reescalados para ele
+  static unsigned long proximoCiclo = micros();
+  proximoCiclo += PERIODO_CONTROLE_US;
+  while ((long)(micros() - proximoCiclo) < 0) {}
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// --- MICRO-BENCHMARK DO CICLO DE EXECUCAO ---
+// Ligado por MODO_BENCHMARK no eva.ino: em vez de treinar, mede o custo de
+// cada etapa de um ciclo de EXECUCAO e imprime um CSV no Serial.
+// Incluído no fim das funções auxiliares do eva.ino (usa os objetos globais).
+//
+// Contagem de ciclos: Timer1 sem prescaler (1 tick = 1 ciclo de CPU) com
+// estouro contado por interrupção -> 32 bits. O Timer1 também gera o PWM do
+// pino 9, então os motores ficam parados durante o benchmark.
+//
+// ATENÇÃO: a medição do salvarLog grava linhas de verdade no arquivo de log
+// do otimizador. Rode com um cartão de teste.
+
+#define BENCH_REPETICOES     200
+#define BENCH_REPETICOES_SD  10
+#define BENCH_PAUSA_CICLO_MS 10 // delay(10) da EXECUCAO: ~6 blocos do ADC esperando a cada leitura
+
+volatile uint16_t benchEstouros = 0;
+volatile float benchSumidouro; // Impede o compilador de apagar a conta medida
+
+ISR(TIMER1_OVF_vect) {
+  benchEstouros++;
+}
+
+uint32_t benchCiclos() {
+  noInterrupts();
+  uint16_t t = TCNT1;
+  uint16_t e = benchEstouros;
+  if ((TIFR1 & _BV(TOV1)) && t < 0x8000) e++; // Estouro pendente
+  interrupts();
+  return ((uint32_t)e << 16) | t;
+}
+
+uint32_t benchOverhead = 0;
+
+// pausaMs: espera antes de cada repetição, fora da medida. Para os kernels
+// que leem o anel do ADC, sem ela só a 1ª chamada drena blocos e as outras
+// medem o anel vazio.
+template <class Kernel>
+void benchMedir(const __FlashStringHelper* nome, uint16_t repeticoes, Kernel kernel, uint16_t pausaMs = 0) {
+  uint32_t minimo = 0xFFFFFFFF;
+  uint32_t total = 0;
+
+  for (uint16_t i = 0; i < repeticoes; i++) {
+    if (pausaMs) delay(pausaMs);
+    uint32_t t0 = benchCiclos();
+    kernel();
+    uint32_t ciclos = benchCiclos() - t0;
+    ciclos = (ciclos > benchOverhead) ? ciclos - benchOverhead : 0;
+
+    if (ciclos < minimo) minimo = ciclos;
+    total += ciclos;
+  }
+
+  // alvo,kernel,unidade,min,media,repeticoes
+  Serial.print(F("avr,")); Serial.print(nome);
+  Serial.print(F(",ciclos,")); Serial.print(minimo);
+  Serial.print(F(",")); Serial.print(total / repeticoes);
+  Serial.print(F(",")); Serial.println(repeticoes);
+  Serial.flush(); // Não deixa a transmissão vazar para a próxima medida
+}
+
+void rodarBenchmark() {
+  pararMotores();
+
+  TCCR1A = 0;
+  TCCR1B = _BV(CS10); // Sem prescaler
+  TCNT1 = 0;
+  TIMSK1 = _BV(TOIE1);
+
+  // Custo da própria medição (duas leituras do contador)
+  benchOverhead = 0xFFFFFFFF;
+  for (int i = 0; i < 32; i++) {
+    uint32_t t0 = benchCiclos();
+    uint32_t ciclos = benchCiclos() - t0;
+    if (ciclos < benchOverhead) benchOverhead = ciclos;
+  }
+
+  Serial.println(F("alvo,kernel,unidade,min,media,repeticoes"));
+
+  int leitura = aquisicao.lerMedia();
+  float cm = CalibracaoPotencia::cm(leitura);
+  filtroDist.setEstimate(cm);
+  pid.ganhos.Kp = 4.0; pid.ganhos.Ki = 1.0; pid.ganhos.Kd = 0.5;
+  custo->reset();
+
+  benchMedir(F("aquisicao_lerMedia"), BENCH_REPETICOES, [&]() { benchSumidouro = aquisicao.lerMedia(); }, BENCH_PAUSA_CICLO_MS);
+  benchMedir(F("calibracao_pow"), BENCH_REPETICOES, [&]() { benchSumidouro = CalibracaoPotencia::cm(leitura); });
+  benchMedir(F("kalman"), BENCH_REPETICOES, [&]() { benchSumidouro = filtroDist.updateEstimate(cm); });
+  benchMedir(F("lerDistancia"), BENCH_REPETICOES, [&]() { benchSumidouro = lerDistancia(); }, BENCH_PAUSA_CICLO_MS);
+  benchMedir(F("pid"), BENCH_REPETICOES, [&]() { benchSumidouro = pid.calcular(3.0, -filtroDist.getVelocidade()); });
+  benchMedir(F("custo_acumular"), BENCH_REPETICOES, [&]() { custo->acumular(3.0, 5000); });
+  benchMedir(F("serial_distancia"), BENCH_REPETICOES, [&]() {
+    Serial.print(F("Distância: "));
+    Serial.print(cm, 4);
+    Serial.println();
+  });
+  benchMedir(F("salvarLog"), BENCH_REPETICOES_SD, [&]() { otimizador->salvarLog(cm, 10.0, 3.0, 1); });
+
+  // analogRead precisa do ADC fora do modo contínuo
+  aquisicao.parar();
+  benchMedir(F("analogRead"), BENCH_REPETICOES, [&]() { benchSumidouro = analogRead(PIN_SENSOR); });
+  aquisicao.iniciar(PIN_SENSOR);
+
+  TIMSK1 = 0;
+  Serial.println(F("BENCH_FIM"));
+}
+
+#endif
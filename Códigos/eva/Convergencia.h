@@ -0,0 +1,110 @@
+#ifndef CONVERGENCIA_H
+#define CONVERGENCIA_H
+
+#include "config.h"
+#include <Arduino.h>
+#include <math.h>
+
+// --- MONITOR DE CONVERGÊNCIA ---
+// Avaliado a cada fim de geração pelo Pso e pelo De. Olha duas coisas:
+//  1. Progresso: o gbest melhorou pelo menos MELHORA_MINIMA (relativa)?
+//  2. Diversidade: espalhamento da população, normalizado pelos limites do PID.
+// Decide entre continuar, re-sortear parte da população (enxame colapsado e
+// sem progresso) ou encerrar o treino (gbest parado por PACIENCIA_ITERACOES).
+// Colapsar ainda melhorando é convergência normal: não reinicia.
+// Fica dentro do estado do otimizador, então vai junto no checkpoint.
+
+enum Decisao {
+    DECISAO_CONTINUA = 0,
+    DECISAO_REINICIO = 1,
+    DECISAO_PARADA   = 2
+};
+
+inline const char* nomeDecisao(uint8_t decisao) {
+    switch (decisao) {
+        case DECISAO_REINICIO: return "REINICIO";
+        case DECISAO_PARADA:   return "PARADA";
+        default:               return "CONTINUA";
+    }
+}
+
+// Desvio padrão médio das dimensões, cada uma dividida pela largura do limite.
+// 0 = todos no mesmo ponto.
+inline float calcularDiversidade(const float pop[NUM_PARTICULAS][NUM_DIMENSOES]) {
+    const float largura[NUM_DIMENSOES] = { KP_MAX - KP_MIN, KI_MAX - KI_MIN, KD_MAX - KD_MIN };
+    float soma = 0;
+
+    for (int d = 0; d < NUM_DIMENSOES; d++) {
+        float media = 0;
+        for (int i = 0; i < NUM_PARTICULAS; i++) media += pop[i][d];
+        media /= NUM_PARTICULAS;
+
+        float variancia = 0;
+        for (int i = 0; i < NUM_PARTICULAS; i++) {
+            float desvio = pop[i][d] - media;
+            variancia += desvio * desvio;
+        }
+        soma += sqrt(variancia / NUM_PARTICULAS) / largura[d];
+    }
+    return soma / NUM_DIMENSOES;
+}
+
+// Índices dos piores da população (nunca o melhor), para o reinício parcial
+inline int escolherPiores(const float custos[NUM_PARTICULAS], int indices[NUM_PARTICULAS]) {
+    int quantidade = (int)(NUM_PARTICULAS * FRACAO_REINICIO);
+    if (quantidade > NUM_PARTICULAS - 1) quantidade = NUM_PARTICULAS - 1;
+
+    bool escolhido[NUM_PARTICULAS] = { false };
+    for (int k = 0; k < quantidade; k++) {
+        int pior = -1;
+        for (int i = 0; i < NUM_PARTICULAS; i++) {
+            if (!escolhido[i] && (pior < 0 || custos[i] > custos[pior])) pior = i;
+        }
+        escolhido[pior] = true;
+        indices[k] = pior;
+    }
+    return quantidade;
+}
+
+struct MonitorConvergencia {
+    float melhor_erro;        // gbest na última melhora que contou
+    int geracoes_sem_melhora;
+    int reinicios;
+    float diversidade;        // Última medida (vai para o log)
+    uint8_t decisao;          // Última decisão (vai para o log)
+
+    void reset() {
+        melhor_erro = 10000000.0;
+        geracoes_sem_melhora = 0;
+        reinicios = 0;
+        diversidade = 1.0;
+        decisao = DECISAO_CONTINUA;
+    }
+
+    uint8_t avaliar(float gbest_erro, float diversidade_atual, int geracao) {
+        diversidade = diversidade_atual;
+
+        if (gbest_erro < melhor_erro * (1.0 - MELHORA_MINIMA)) {
+            melhor_erro = gbest_erro;
+            geracoes_sem_melhora = 0;
+        } else {
+            geracoes_sem_melhora++;
+        }
+
+        if (diversidade < DIVERSIDADE_MINIMA && geracoes_sem_melhora >= PACIENCIA_REINICIO &&
+            reinicios < MAX_REINICIOS) {
+            reinicios++;
+            geracoes_sem_melhora = 0; // Dá tempo aos novos indivíduos
+            decisao = DECISAO_REINICIO;
+        } else if (geracoes_sem_melhora >= PACIENCIA_ITERACOES && geracao >= MIN_ITERACOES) {
+            decisao = DECISAO_PARADA;
+        } else {
+            decisao = DECISAO_CONTINUA;
+        }
+        return decisao;
+    }
+
+    bool isParado() const { return decisao == DECISAO_PARADA; }
+};
+
+#endif
@@ -6,6 +6,7 @@ De::De() {
     estado.geracao_atual = 0;
     estado.individuo_atual = 0;
     estado.gbest_erro = 10000000.0;
+    estado.monitor.reset();
 }
 
 float De::randomFloat(float min, float max) {
@@ -18,6 +19,7 @@ void De::inicializar() {
     estado.geracao_atual = 0;
     estado.individuo_atual = 0;
     estado.gbest_erro = 10000000.0;
+    estado.monitor.reset();
 
     for (int i = 0; i < NUM_PARTICULAS; i++) {
         // Inicializa população aleatória
@@ -69,6 +71,14 @@ void De::gerarVetorTeste(int i) {
     limitarParametros(estado.vetor_teste);
 }
 
+void De::prepararCandidato() {
+    // Nas gerações seguintes à primeira, precisamos gerar um DESAFIANTE (Trial Vector)
+    // para competir contra o indivíduo atual. Na geração 0 não há o que gerar.
+    if (estado.geracao_atual > 0) {
+        gerarVetorTeste(estado.individuo_atual);
+    }
+}
+
 void De::getParametrosAtuais(float &kp, float &ki, float &kd) {
     int i = estado.individuo_atual;
 
@@ -78,18 +88,7 @@ void De::getParametrosAtuais(float &kp, float &ki, float &kd) {
         ki = estado.populacao[i][1];
         kd = estado.populacao[i][2];
     } else {
-        // Nas gerações seguintes, precisamos gerar um DESAFIANTE (Trial Vector)
-        // para competir contra o indivíduo atual.
-        // Como o getParametros pode ser chamado várias vezes, idealmente já teríamos gerado.
-        // Mas vamos gerar aqui caso seja a primeira chamada do ciclo.
-        
-        // OBS: Geramos o vetor teste logicamente antes de enviar para o robô.
-        // Para simplificar, recalculamos sempre que pede, pois é determinístico com semente fixa
-        // mas como usamos random(), vamos confiar que o fluxo proximaParticula garante a ordem.
-        
-        // Nota: A geração real acontece aqui para ser enviada ao robô
-        gerarVetorTeste(i); 
-        
+        // Vetor teste já gerado pelo prepararCandidato (pode chamar várias vezes)
         kp = estado.vetor_teste[0];
         ki = estado.vetor_teste[1];
         kd = estado.vetor_teste[2];
@@ -152,21 +151,44 @@ void De::proximaParticula() {
         estado.geracao_atual++;
         Serial.print(F("DE: Fim da geracao "));
         Serial.println(estado.geracao_atual);
+
+        uint8_t decisao = estado.monitor.avaliar(estado.gbest_erro, calcularDiversidade(estado.populacao), estado.geracao_atual);
+        Serial.print(F("DE: Diversidade ")); Serial.print(estado.monitor.diversidade, 3);
+        Serial.print(F(" -> ")); Serial.println(nomeDecisao(decisao));
+        if (decisao == DECISAO_REINICIO) reiniciarParcial();
+    }
+}
+
+// População colapsou cedo: re-sorteia os piores indivíduos. Sem custo
+// conhecido, o primeiro desafiante de cada um sempre entra no lugar.
+void De::reiniciarParcial() {
+    int piores[NUM_PARTICULAS];
+    int quantidade = escolherPiores(estado.custos, piores);
+
+    for (int k = 0; k < quantidade; k++) {
+        int i = piores[k];
+        estado.populacao[i][0] = randomFloat(KP_MIN, KP_MAX);
+        estado.populacao[i][1] = randomFloat(KI_MIN, KI_MAX);
+        estado.populacao[i][2] = randomFloat(KD_MIN, KD_MAX);
+        estado.custos[i] = 10000000.0;
     }
 }
 
 bool De::isConcluido() {
-    return (estado.geracao_atual >= MAX_ITERACOES);
+    return (estado.geracao_atual >= MAX_ITERACOES) || estado.monitor.isParado();
 }
 
 // --- PERSISTÊNCIA ---
 void De::salvarEstado() {
     if (SD.exists(DE_DADOS_BIN)) SD.remove(DE_DADOS_BIN);
     
-    File arquivo = SD.open(DE_DADOS_BIN, FILE_WRITE);
+    File arquivo = abrirArquivo(DE_DADOS_BIN, FILE_WRITE);
     if (arquivo) {
+        unsigned long inicio = micros();
         arquivo.write((uint8_t *)&estado, sizeof(estado));
-        arquivo.close();
+        metricas.salvar(arquivo); // Métricas vão junto no checkpoint
+        metricas.registrarDesde(HIST_SD_ESCREVER, inicio);
+        fecharArquivo(arquivo);
     } else {
         Serial.println(F("DE ERRO: Falha salvar BIN!"));
     }
@@ -178,6 +200,7 @@ bool De::carregarEstado() {
     File arquivo = SD.open(DE_DADOS_BIN, FILE_READ);
     if (arquivo) {
         arquivo.read((uint8_t *)&estado, sizeof(estado));
+        metricas.carregar(arquivo);
         arquivo.close();
         if (estado.inicializado) {
             Serial.println(F("DE: Save carregado."));
@@ -198,32 +221,51 @@ void De::imprimirStatus() {
     Serial.print(estado.gbest_pos[2]); Serial.println(F("]"));
 }
 
-void De::salvarLog(float distancia, float pwm, float erro) {
-    File dataFile = SD.open(DE_DADOS, FILE_WRITE);
+void De::salvarLog(float distancia, float pwm, float erro, uint16_t passo) {
+    File dataFile = abrirArquivo(DE_DADOS, FILE_WRITE);
     if (dataFile) {
-        if (dataFile.size() == 0) dataFile.println("Ger,Ind,Dist,PWM,Erro,Gbest_Erro");
+        unsigned long inicio = micros();
+        if (dataFile.size() == 0) dataFile.println("Ger,Ind,Dist,PWM,Erro,Gbest_Erro,Passo");
         
         dataFile.print(estado.geracao_atual); dataFile.print(",");
         dataFile.print(estado.individuo_atual); dataFile.print(",");
         dataFile.print(distancia); dataFile.print(",");
         dataFile.print(pwm); dataFile.print(",");
         dataFile.print(erro); dataFile.print(",");
-        dataFile.println(estado.gbest_erro);
-        dataFile.close();
+        dataFile.print(estado.gbest_erro); dataFile.print(",");
+        dataFile.println(passo);
+        metricas.registrarDesde(HIST_SD_ESCREVER, inicio);
+        fecharArquivo(dataFile);
     }
 }
 
 void De::salvarConvergencia() {
-    File dataFile = SD.open(DE_CONVERGENCIA, FILE_WRITE);
+    File dataFile = abrirArquivo(DE_CONVERGENCIA, FILE_WRITE);
     if (dataFile) {
-        if (dataFile.size() == 0) dataFile.println("Geracao,Gbest_Erro,Kp,Ki,Kd");
+        unsigned long inicio = micros();
+        if (dataFile.size() == 0) dataFile.println(DE_CABECALHO_CONVERGENCIA);
         
         dataFile.print(estado.geracao_atual); dataFile.print(",");
         dataFile.print(estado.gbest_erro); dataFile.print(",");
         dataFile.print(estado.gbest_pos[0]); dataFile.print(",");
         dataFile.print(estado.gbest_pos[1]); dataFile.print(",");
-        dataFile.println(estado.gbest_pos[2]);
-        dataFile.close();
+        dataFile.print(estado.gbest_pos[2]); dataFile.print(",");
+        dataFile.print(calcularDiversidade(estado.populacao), 3); dataFile.print(",");
+        // Decisão só na linha logo após o fim da geração
+        dataFile.println(estado.individuo_atual == 0 ? nomeDecisao(estado.monitor.decisao) : "-");
+        metricas.registrarDesde(HIST_SD_ESCREVER, inicio);
+        fecharArquivo(dataFile);
+    }
+}
+
+void De::anotarConvergencia(const __FlashStringHelper* nota) {
+    File dataFile = abrirArquivo(DE_CONVERGENCIA, FILE_WRITE);
+    if (dataFile) {
+        unsigned long inicio = micros();
+        if (dataFile.size() == 0) dataFile.println(DE_CABECALHO_CONVERGENCIA);
+        dataFile.print("# "); dataFile.println(nota);
+        metricas.registrarDesde(HIST_SD_ESCREVER, inicio);
+        fecharArquivo(dataFile);
     }
 }
 
@@ -3,12 +3,15 @@
 
 #include "Otimizador.h"
 #include "config.h"
+#include "Convergencia.h"
+#include "Metricas.h"
 #include <SD.h>
 #include <Arduino.h>
 
 // Nomes dos arquivos do SD
 #define DE_DADOS_BIN     "de_data.bin"
 #define DE_CONVERGENCIA  "DE_CONV.txt"
+#define DE_CABECALHO_CONVERGENCIA "Geracao,Gbest_Erro,Kp,Ki,Kd,Diversidade,Decisao"
 #define DE_DADOS         "DE_DADOS.txt"
 
 // Parâmetros do Algoritmo DE
@@ -35,6 +38,7 @@ private:
         float gbest_erro;
         
         bool inicializado;
+        MonitorConvergencia monitor; // No fim: saves antigos continuam legíveis
     };
 
     DeState estado;
@@ -44,12 +48,14 @@ private:
     float randomFloat(float min, float max);
     void limitarParametros(float* vetor);
     void gerarVetorTeste(int indice_alvo);
+    void reiniciarParcial();
 
 public:
     De(); // Construtor
 
     // --- Implementação da Interface Otimizador ---
     void inicializar() override;
+    void prepararCandidato() override;
     void getParametrosAtuais(float &kp, float &ki, float &kd) override;
     void setErroDaRodada(float erro) override;
     void  proximaParticula() override;
@@ -60,8 +66,9 @@ public:
     bool carregarEstado() override;
 
     // Logs
-    void salvarLog(float dist, float pwm, float erro) override;
+    void salvarLog(float dist, float pwm, float erro, uint16_t passo) override;
     void salvarConvergencia() override;
+    void anotarConvergencia(const __FlashStringHelper* nota) override;
     void apagarDados() override;
     void imprimirStatus() override;
 };
@@ -0,0 +1,82 @@
+#include "Metricas.h"
+
+Metricas metricas;
+
+static const __FlashStringHelper* nomeContador(uint8_t c) {
+  switch (c) {
+    case CONT_BOOT:              return F("boot");
+    case CONT_SD_FALHA_ABERTURA: return F("sd_falha_abertura");
+    case CONT_SD_FALHA_ESCRITA:  return F("sd_falha_escrita");
+    default:                     return F("kalman_reset");
+  }
+}
+
+static const __FlashStringHelper* nomeHistograma(uint8_t h) {
+  switch (h) {
+    case HIST_BOOT:        return F("estado_boot");
+    case HIST_CONTAGEM:    return F("estado_contagem");
+    case HIST_EXECUCAO:    return F("estado_execucao");
+    case HIST_AVALIACAO:   return F("estado_avaliacao");
+    case HIST_SALVAMENTO:  return F("salvamento");
+    case HIST_SD_ABRIR:    return F("sd_abrir");
+    case HIST_SD_ESCREVER: return F("sd_escrever");
+    default:               return F("sd_fechar");
+  }
+}
+
+void Metricas::salvar(File& arquivo) {
+  arquivo.write((uint8_t *)this, sizeof(*this));
+}
+
+// Save antigo (sem métricas) ou de outro layout: começa do zero.
+// Lê direto em this: uma cópia temporária custaria ~240 bytes de pilha.
+bool Metricas::carregar(File& arquivo) {
+  if (arquivo.read((uint8_t *)this, sizeof(*this)) == (int)sizeof(*this) &&
+      assinatura == METRICAS_ASSINATURA) {
+    return true;
+  }
+  zerar();
+  return false;
+}
+
+// CSV no Serial: contadores, depois um histograma por linha
+void Metricas::imprimir(uint16_t descartesAdc) {
+  Serial.println(F("--- METRICAS ---"));
+  Serial.println(F("contador,valor"));
+  for (uint8_t c = 0; c < NUM_CONTADORES; c++) {
+    Serial.print(nomeContador(c)); Serial.print(F(","));
+    Serial.println(contadores[c]);
+  }
+  Serial.print(F("adc_descartes,")); Serial.println(descartesAdc); // Desde o boot, não vai no checkpoint
+
+  Serial.print(F("histograma,escala,max_us"));
+  for (uint8_t k = 0; k < METRICAS_BALDES; k++) {
+    Serial.print(F(",b")); Serial.print(k);
+  }
+  Serial.println();
+  for (uint8_t h = 0; h < NUM_HISTOGRAMAS; h++) {
+    Serial.print(nomeHistograma(h));
+    Serial.print(emSegundos(h) ? F(",1s,") : F(",log4_us,"));
+    Serial.print(maximo[h]);
+    for (uint8_t k = 0; k < METRICAS_BALDES; k++) {
+      Serial.print(F(",")); Serial.print(baldes[h][k]);
+    }
+    Serial.println();
+  }
+  Serial.println(F("(balde bk: log4_us = de 4^k a 4^(k+1) us; 1s = de k a k+1 s)"));
+}
+
+File abrirArquivo(const char* nome, uint8_t modo) {
+  unsigned long inicio = micros();
+  File arquivo = SD.open(nome, modo);
+  metricas.registrarDesde(HIST_SD_ABRIR, inicio);
+  if (!arquivo) metricas.contar(CONT_SD_FALHA_ABERTURA);
+  return arquivo;
+}
+
+void fecharArquivo(File& arquivo) {
+  if (arquivo.getWriteError()) metricas.contar(CONT_SD_FALHA_ESCRITA);
+  unsigned long inicio = micros();
+  arquivo.close();
+  metricas.registrarDesde(HIST_SD_FECHAR, inicio);
+}
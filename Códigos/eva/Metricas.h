@@ -0,0 +1,92 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <Arduino.h>
+#include <SD.h>
+#include <string.h>
+
+// --- MÉTRICAS DE CAMPO ---
+// Contadores e histogramas de latência com memória fixa, para diagnosticar
+// lentidão e falhas do robô sem gravar um firmware de debug. Atualizar custa
+// um micros() e alguns deslocamentos.
+// Vai junto no checkpoint (logo depois do estado do otimizador) e é impresso
+// pelo comando 'm' no Serial ('z' zera). Ver atenderSerial() no eva.ino.
+//
+// Histograma: balde k conta as medidas em [4^k, 4^(k+1)) us (o 0 começa em 0);
+// o último pega tudo acima de 4^11 us (~4,2 s). BOOT, CONTAGEM e EXECUCAO
+// duram segundos e cairiam todos no último: neles o balde k é [k, k+1) s
+// (o último, 11 s ou mais). Contagens saturam em 65535. Ocupa ~240 bytes de RAM.
+
+#define METRICAS_BALDES     12
+#define METRICAS_ASSINATURA 0x4D32 // Muda se o layout mudar: save antigo é ignorado
+
+enum Contador {
+  CONT_BOOT = 0,            // Boots com este checkpoint (queda de energia = boot a mais)
+  CONT_SD_FALHA_ABERTURA,   // SD.open que falhou
+  CONT_SD_FALHA_ESCRITA,    // Arquivo fechado com erro de escrita
+  CONT_KALMAN_RESET,        // Filtro reinicializado (uma por rodada)
+  NUM_CONTADORES
+};
+
+enum Histograma {
+  // Duração de cada estado: mesma ordem do enum Estado do eva.ino
+  HIST_BOOT = 0,
+  HIST_CONTAGEM,
+  HIST_EXECUCAO,            // Até aqui: baldes de 1 s
+  HIST_AVALIACAO,
+  HIST_SALVAMENTO,          // Cada gravação da contagem (checkpoint ou convergência)
+  HIST_SD_ABRIR,
+  HIST_SD_ESCREVER,
+  HIST_SD_FECHAR,           // Inclui o flush do bloco para o cartão
+  NUM_HISTOGRAMAS
+};
+
+struct Metricas {
+  uint16_t assinatura;
+  uint32_t contadores[NUM_CONTADORES];
+  uint16_t baldes[NUM_HISTOGRAMAS][METRICAS_BALDES];
+  uint32_t maximo[NUM_HISTOGRAMAS]; // us
+
+  void zerar() {
+    memset(this, 0, sizeof(*this));
+    assinatura = METRICAS_ASSINATURA;
+  }
+
+  void contar(uint8_t c) { contadores[c]++; }
+
+  void registrar(uint8_t h, uint32_t us) {
+    if (us > maximo[h]) maximo[h] = us;
+
+    uint8_t k = 0;
+    if (emSegundos(h)) {
+      uint32_t s = us / 1000000UL; // Só nas trocas de estado: a divisão não pesa
+      k = (s < METRICAS_BALDES - 1) ? s : METRICAS_BALDES - 1;
+    } else {
+      for (uint32_t resto = us >> 2; resto && k < METRICAS_BALDES - 1; resto >>= 2) k++;
+    }
+    if (baldes[h][k] != 0xFFFF) baldes[h][k]++;
+  }
+
+  static bool emSegundos(uint8_t h) { return h <= HIST_EXECUCAO; }
+
+  // Registra micros() - inicio e devolve o micros() atual (para encadear medidas)
+  unsigned long registrarDesde(uint8_t h, unsigned long inicio) {
+    unsigned long agora = micros();
+    registrar(h, agora - inicio);
+    return agora;
+  }
+
+  // Checkpoint: vai no fim do arquivo do otimizador
+  void salvar(File& arquivo);
+  bool carregar(File& arquivo);
+
+  void imprimir(uint16_t descartesAdc); // Descartes da AquisicaoAdc, impressos junto
+};
+
+extern Metricas metricas;
+
+// SD.open/close medidos, contando as falhas
+File abrirArquivo(const char* nome, uint8_t modo);
+void fecharArquivo(File& arquivo);
+
+#endif
@@ -9,6 +9,9 @@ public:
 
     // --- MÉTODOS DE CONTROLE ---
     virtual void inicializar() = 0;
+    // Gera o próximo candidato com antecedência (chamado durante a CONTAGEM),
+    // para o getParametrosAtuais só devolver valores prontos.
+    virtual void prepararCandidato() = 0;
     virtual void getParametrosAtuais(float &kp, float &ki, float &kd) = 0;
     virtual void setErroDaRodada(float erro) = 0;
     virtual void proximaParticula() = 0;
@@ -23,8 +26,11 @@ public:
 
     // 2. Log CSV/Excel (Salva o Relatório para você ler depois)
     // NOVO: Recebe os dados da rodada para gravar no DADOS.txt
-    virtual void salvarLog(float dist, float pwm, float erro) = 0;
+    // passo: passadas do laço desde o início da rodada (período real do treino)
+    virtual void salvarLog(float dist, float pwm, float erro, uint16_t passo) = 0;
     virtual void salvarConvergencia() = 0;
+    // Linha "# nota" no log de convergência (ex.: filtro do firmware a cada boot)
+    virtual void anotarConvergencia(const __FlashStringHelper* nota) = 0;
 
     virtual void apagarDados() = 0;
     
@@ -8,6 +8,7 @@ Pso::Pso() {
     estado.iteracao_atual = 0;
     estado.particula_atual = 0;
     estado.gbest_erro = 10000000.0; // Infinito inicial
+    estado.monitor.reset();
 }
 
 float Pso::randomFloat(float min, float max) {
@@ -20,6 +21,8 @@ void Pso::inicializar() {
     estado.iteracao_atual = 0;
     estado.particula_atual = 0;
     estado.gbest_erro = 10000000.0; // Um valor muito alto
+    estado.W = 0.9;
+    estado.monitor.reset();
 
     for (int i = 0; i < NUM_PARTICULAS; i++) {
         // 1. Posições iniciais aleatórias dentro dos limites do PID
@@ -39,6 +42,10 @@ void Pso::inicializar() {
     salvarEstado(); // Garante que o arquivo exista logo de cara
 }
 
+void Pso::prepararCandidato() {
+    // Nada a fazer: a nova posição da partícula já sai do setErroDaRodada
+}
+
 void Pso::getParametrosAtuais(float &kp, float &ki, float &kd) {
     int i = estado.particula_atual;
     kp = estado.x[i][0];
@@ -115,11 +122,36 @@ void Pso::proximaParticula() {
         estado.W = estado.W + estado.W_passo;
         Serial.print(F("PSO: Fim da iteração "));
         Serial.println(estado.iteracao_atual);
+
+        uint8_t decisao = estado.monitor.avaliar(estado.gbest_erro, calcularDiversidade(estado.x), estado.iteracao_atual);
+        Serial.print(F("PSO: Diversidade ")); Serial.print(estado.monitor.diversidade, 3);
+        Serial.print(F(" -> ")); Serial.println(nomeDecisao(decisao));
+        if (decisao == DECISAO_REINICIO) reiniciarParcial();
+    }
+}
+
+// Enxame colapsou cedo: re-sorteia as piores partículas (posição, velocidade e
+// memória) e devolve a inércia ao valor inicial para voltar a explorar.
+void Pso::reiniciarParcial() {
+    int piores[NUM_PARTICULAS];
+    int quantidade = escolherPiores(estado.pbest_erro, piores);
+
+    for (int k = 0; k < quantidade; k++) {
+        int i = piores[k];
+        estado.x[i][0] = randomFloat(KP_MIN, KP_MAX);
+        estado.x[i][1] = randomFloat(KI_MIN, KI_MAX);
+        estado.x[i][2] = randomFloat(KD_MIN, KD_MAX);
+        for (int d = 0; d < NUM_DIMENSOES; d++) {
+            estado.v[i][d] = 0.0;
+            estado.pbest_pos[i][d] = estado.x[i][d];
+        }
+        estado.pbest_erro[i] = 10000000.0;
     }
+    estado.W = 0.9;
 }
 
 bool Pso::isConcluido() {
-    return (estado.iteracao_atual >= MAX_ITERACOES);
+    return (estado.iteracao_atual >= MAX_ITERACOES) || estado.monitor.isParado();
 }
 
 // --- PERSISTÊNCIA NO CARTÃO SD ---
@@ -130,11 +162,14 @@ void Pso::salvarEstado() {
         SD.remove(DADOS_BIN);
     }
 
-    File arquivo = SD.open(DADOS_BIN, FILE_WRITE);
+    File arquivo = abrirArquivo(DADOS_BIN, FILE_WRITE);
     if (arquivo) {
         // Escreve a struct inteira como um bloco de bytes
+        unsigned long inicio = micros();
         arquivo.write((uint8_t *)&estado, sizeof(estado));
-        arquivo.close();
+        metricas.salvar(arquivo); // Métricas vão junto no checkpoint
+        metricas.registrarDesde(HIST_SD_ESCREVER, inicio);
+        fecharArquivo(arquivo);
         // Serial.println("PSO: Checkpoint salvo no SD.");
     } else {
         Serial.println(F("PSO ERRO: Falha ao salvar no SD!"));
@@ -151,6 +186,7 @@ bool Pso::carregarEstado() {
     if (arquivo) {
         // Lê os bytes e preenche a struct
         arquivo.read((uint8_t *)&estado, sizeof(estado));
+        metricas.carregar(arquivo);
         arquivo.close();
 
         // Verificação básica de integridade
@@ -177,10 +213,11 @@ void Pso::imprimirStatus() {
 }
 
 
-void Pso::salvarLog(float distancia, float pwm, float erro) {
-    File dataFile = SD.open(DADOS, FILE_WRITE);
+void Pso::salvarLog(float distancia, float pwm, float erro, uint16_t passo) {
+    File dataFile = abrirArquivo(DADOS, FILE_WRITE);
 
     if (dataFile) {
+        unsigned long inicio = micros();
         // Se arquivo novo, cria cabeçalho
         if (dataFile.size() == 0) {
             dataFile.println("Iteracao,Particula,Distancia,PWM,Erro_Atual,Gbest_Erro, Passo");
@@ -196,12 +233,15 @@ void Pso::salvarLog(float distancia, float pwm, float erro) {
         dataFile.print(",");
         dataFile.print(erro);
         dataFile.print(",");
-        dataFile.println(estado.gbest_erro);
+        dataFile.print(estado.gbest_erro);
+        dataFile.print(",");
+        dataFile.println(passo);
         // dataFile.print(estado.gbest_erro);
         // dataFile.print(",");
         // dataFile.println(estado.W);
 
-        dataFile.close();
+        metricas.registrarDesde(HIST_SD_ESCREVER, inicio);
+        fecharArquivo(dataFile);
     }
 }
 
@@ -209,13 +249,14 @@ void Pso::salvarLog(float distancia, float pwm, float erro) {
 void Pso::salvarConvergencia(){
 
     Serial.print(F("Salvando convergência...\n"));
-    File dataFile = SD.open(CONVERGENCIA, FILE_WRITE);
+    File dataFile = abrirArquivo(CONVERGENCIA, FILE_WRITE);
 
     if (dataFile){
         Serial.print(F("Abriu o arquivo 'Convergência'!\n"));
+        unsigned long inicio = micros();
         // Se arquivo novo, cria cabeçalho
         if(dataFile.size() == 0){
-            dataFile.println("Iteração,Gbest_Erro, Kp_best, Ki_best, Kd_best");
+            dataFile.println(CABECALHO_CONVERGENCIA);
         }
 
         dataFile.print(estado.iteracao_atual);
@@ -226,14 +267,37 @@ void Pso::salvarConvergencia(){
         dataFile.print(",");
         dataFile.print(estado.gbest_pos[1]);
         dataFile.print(",");
-        dataFile.println(estado.gbest_pos[2]);
+        dataFile.print(estado.gbest_pos[2]);
+        dataFile.print(",");
+        dataFile.print(calcularDiversidade(estado.x), 3);
+        dataFile.print(",");
+        // Decisão só na linha logo após o fim da geração
+        dataFile.println(estado.particula_atual == 0 ? nomeDecisao(estado.monitor.decisao) : "-");
 
-        dataFile.close();
+        metricas.registrarDesde(HIST_SD_ESCREVER, inicio);
+        fecharArquivo(dataFile);
 
         Serial.print(F("Convergência salva!\n"));
     }
 }
 
+void Pso::anotarConvergencia(const __FlashStringHelper* nota){
+    File dataFile = abrirArquivo(CONVERGENCIA, FILE_WRITE);
+
+    if (dataFile){
+        unsigned long inicio = micros();
+        if(dataFile.size() == 0){
+            dataFile.println(CABECALHO_CONVERGENCIA);
+        }
+
+        dataFile.print("# ");
+        dataFile.println(nota);
+
+        metricas.registrarDesde(HIST_SD_ESCREVER, inicio);
+        fecharArquivo(dataFile);
+    }
+}
+
 
 void Pso::apagarDados(){
     
@@ -3,12 +3,15 @@
 
 #include "Otimizador.h"
 #include "config.h"
+#include "Convergencia.h"
+#include "Metricas.h"
 #include <SD.h>
 #include <Arduino.h>
 
 // Nomes dos arquivos do SD
 #define DADOS_BIN     "pso_data.bin"
 #define CONVERGENCIA  "CONVERG.txt"
+#define CABECALHO_CONVERGENCIA "Iteração,Gbest_Erro, Kp_best, Ki_best, Kd_best, Diversidade, Decisao"
 #define DADOS         "DADOS.txt"
 
 // Constantes do PSO
@@ -31,6 +34,7 @@ private:
         float W = 0.9;    // Inércia
         float W_f = 0.3;   // Inércia Final
         float W_passo = (W_f - W) / MAX_ITERACOES; // Passo da inércia
+        MonitorConvergencia monitor; // No fim: saves antigos continuam legíveis
     };
 
     PsoState estado;
@@ -40,6 +44,7 @@ private:
     // Métodos privados
     float randomFloat(float min, float max);
     void limitarPosicao(int p_idx);
+    void reiniciarParcial();
 
 public:
     
@@ -47,6 +52,7 @@ public:
     
     // --- Implementação da Interface Otimizador ---
     void inicializar() override;
+    void prepararCandidato() override;
     void getParametrosAtuais(float &kp, float &ki, float &kd) override;
     void setErroDaRodada(float erro) override;
     void proximaParticula() override;
@@ -57,8 +63,9 @@ public:
     bool carregarEstado() override;
     
     // Log Legível (Excel/CSV) - A PEÇA QUE FALTAVA
-    void salvarLog(float dist, float pwm, float erro) override;
+    void salvarLog(float dist, float pwm, float erro, uint16_t passo) override;
     void salvarConvergencia() override;
+    void anotarConvergencia(const __FlashStringHelper* nota) override;
 
     void apagarDados() override;
     
@@ -9,4 +9,13 @@
 #define KI_MIN 0.0
 #define KI_MAX 3.0
 #define KD_MIN 0.0
-#define KD_MAX 3.0
\ No newline at end of file
+#define KD_MAX 3.0
+
+// --- CRITÉRIOS DE CONVERGÊNCIA (ver Convergencia.h) ---
+#define MIN_ITERACOES 10         // Nunca encerra antes disso
+#define PACIENCIA_ITERACOES 10   // Gerações sem melhora para encerrar
+#define MELHORA_MINIMA 0.01      // Melhora relativa do gbest que conta como progresso (1%)
+#define DIVERSIDADE_MINIMA 0.05  // Espalhamento normalizado abaixo disso = enxame colapsado
+#define PACIENCIA_REINICIO 3     // Colapsado e sem melhora por isso -> reinício parcial
+#define FRACAO_REINICIO 0.5      // Fração da população re-sorteada num reinício
+#define MAX_REINICIOS 3
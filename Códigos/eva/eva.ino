@@ -4,7 +4,7 @@
 #include "Pso.h"
 #include "De.h"
 #include "Custos.h"
-#include "Kalman.h"
+#include <EvaNucleo.h>
 
 // --- PINAGEM DO HARDWARE ---
 const int PIN_ESQ_PWM = 5;
@@ -13,6 +13,7 @@ const int PIN_DIR_PWM = 9;
 const int PIN_DIR_GND = 6;
 const int PIN_LED     = 7;
 const int PIN_SENSOR  = A0;
+const int PIN_BOTAO   = 2;  // Botão até o GND: "robô posicionado" (opcional)
 
 // --- CORREÇÃO APLICADA AQUI ---
 const int PIN_CS_SD   = 4; // Confirmado: Seu CS é o 4!
@@ -22,42 +23,76 @@ const unsigned long TEMPO_DE_EXECUCAO_MS = 10000; // 10 segundos de teste por pa
 const int SETPOINT_DISTANCIA = 65;               // Queremos manter 65cm
 const int VELOCIDADE_BASE = 125;                  // Velocidade da roda direita (Fixa)
 
+// --- CONTAGEM (REPOSICIONAMENTO) ---
+const unsigned long TEMPO_CONTAGEM_MS = 10000;    // Tempo máximo para reposicionar
+const unsigned long TEMPO_AVISO_MS = 3000;        // Pisca rápido (Solte!) antes de largar
+// A contagem pode acabar antes: botão apertado ou robô movido e parado de
+// novo na posição de largada. Sobra só o aviso.
+#define FIM_POR_BOTAO  1
+#define FIM_POR_SENSOR 1
+const unsigned long TEMPO_PARADO_MS = 1500;       // Sensor estável por este tempo = posicionado
+const float TOLERANCIA_PARADO_CM = 2.0;           // Variação máxima da leitura "parada"
+const float LIMIAR_MOVIMENTO_CM = 5.0;            // Saiu disso da posição final = foi movido...
+const unsigned long TEMPO_MOVIMENTO_MS = 300;     // ...se ficar fora por este tempo (ruído e vultos não contam)
+const float DIST_LARGADA_CM = 40.0;               // Onde o robô é colocado (logs dos exp*: ~39-40cm)
+const float FAIXA_LARGADA_CM = 5.0;               // Parado fora disso não é "posicionado"
+
+// 1 = mede o custo de cada etapa do ciclo e imprime CSV no Serial (não treina)
+#define MODO_BENCHMARK 0
+
 // --- ESTADOS DA MÁQUINA ---
 enum Estado {
   BOOT,           // Inicialização
-  CONTAGEM,       // 10s para reposicionar (Pisca LED)
+  CONTAGEM,       // Reposicionar (Pisca LED) + checkpoint no SD em segundo plano
   EXECUCAO,       // Robô andando (PID ativo)
-  AVALIACAO,      // Cálculo da nota
-  SALVAMENTO      // Gravação no SD
+  AVALIACAO       // Cálculo da nota
+};
+
+// --- TAREFAS DA CONTAGEM ---
+// O robô fica parado durante a contagem: o checkpoint e o próximo candidato
+// são feitos nesse tempo morto, uma tarefa por passada do loop (o LED e a
+// detecção de posição continuam respondendo entre uma e outra).
+enum Tarefa {
+  TAREFA_CANDIDATO    = 1, // Otimizador gera o próximo Kp, Ki, Kd
+  TAREFA_ESTADO       = 2, // Checkpoint binário (cérebro)
+  TAREFA_CONVERGENCIA = 4  // Linha no arquivo de convergência
 };
+uint8_t tarefasPendentes = 0;
 
 Estado estadoAtual = BOOT;
 unsigned long tempoInicioEstado = 0;
+unsigned long inicioEstadoUs = 0; // Para o histograma de duração (BOOT conta desde o reset)
 
 // Objetos Globais
 Otimizador* otimizador = nullptr;
 FuncaoCusto* custo = nullptr;
 
 // --- CRIAÇÃO DO FILTRO KALMAN ---
-// (IncertezaMedicao, IncertezaEstimativa, RuidoProcesso)
-SimpleKalmanFilter filtroDist(4.0, 2.0, 0.3);
+// Distância + velocidade com ganho estacionário (ver FiltroKalman.h)
+KalmanVelocidade<CoefKalmanPadrao> filtroDist;
+// Anotado no log de convergência a cada boot: o gerador_sintonia.py lê dali
+// com que filtro (e termo D) cada linha foi treinada. Troque junto com o filtro.
+#define FILTRO_TREINO "velocidade"
 
-// Variáveis de Controle
-float Kp = 0, Ki = 0, Kd = 0;
-float erroAnterior = 0, integralErro = 0;
+// Fim da contagem (pode ser antecipado) e detecção de "robô posicionado"
+unsigned long fimContagem = 0;
+float distReferencia = 0, janelaMin = 0, janelaMax = 0;
+unsigned long inicioJanela = 0, inicioFora = 0;
+bool viuMovimento = false, fora = false;
+
+// Variáveis de Controle (ganhos trocados a cada partícula)
+ControlePid<GanhosVariaveis> pid;
 float dist = 0, erro = 0, pid_out = 0;
+uint16_t passosRodada = 0; // Vai no log: o gerador_sintonia.py tira dele o período do laço
 // --- FUNÇÕES AUXILIARES ---
 
 float lerDistancia() {
-  int leitura = analogRead(PIN_SENSOR);
+  int leitura = aquisicao.lerMedia(); // Já sobreamostrada pela ISR
   // Sua equação calibrada
-  float cm = 10650.08 * pow(leitura,-0.935) - 10;
+  float cm = CalibracaoPotencia::cm(leitura);
   float cm_filtrado = filtroDist.updateEstimate(cm);
 
-  if (cm_filtrado < 40) cm_filtrado = 40;
-  if (cm_filtrado > 90) cm_filtrado = 90;
-
-  return cm_filtrado;
+  return limitarDistancia(cm_filtrado);
 }
 
 void pararMotores() {
@@ -84,9 +119,104 @@ void piscarLed(int intervalo) {
   else digitalWrite(PIN_LED, LOW);
 }
 
+// Registra quanto tempo o estado atual durou e passa para o próximo
+void trocarEstado(Estado novo) {
+  inicioEstadoUs = metricas.registrarDesde(HIST_BOOT + estadoAtual, inicioEstadoUs);
+  estadoAtual = novo;
+}
+
+void iniciarContagem(uint8_t tarefas) {
+  tarefasPendentes = tarefas;
+  tempoInicioEstado = millis();
+  fimContagem = tempoInicioEstado + TEMPO_CONTAGEM_MS;
+
+  distReferencia = CalibracaoPotencia::cm(aquisicao.lerMedia());
+  janelaMin = janelaMax = distReferencia;
+  inicioJanela = tempoInicioEstado;
+  viuMovimento = false;
+  fora = false;
+
+  trocarEstado(CONTAGEM);
+}
+
+// Executa a próxima tarefa pendente (uma por chamada)
+void executarTarefa() {
+  if (tarefasPendentes & TAREFA_CANDIDATO) {
+    otimizador->prepararCandidato();
+    tarefasPendentes &= ~TAREFA_CANDIDATO;
+  } else if (tarefasPendentes & TAREFA_ESTADO) {
+    unsigned long inicio = micros();
+    otimizador->salvarEstado(); // Salva binário (cérebro)
+    metricas.registrarDesde(HIST_SALVAMENTO, inicio);
+    tarefasPendentes &= ~TAREFA_ESTADO;
+  } else if (tarefasPendentes & TAREFA_CONVERGENCIA) {
+    unsigned long inicio = micros();
+    otimizador->salvarConvergencia(); // Salva a convergência
+    metricas.registrarDesde(HIST_SALVAMENTO, inicio);
+    tarefasPendentes &= ~TAREFA_CONVERGENCIA;
+  }
+  // O SD travou o loop de propósito (dezenas de ms): o anel encheu sem ser
+  // perda, e o roboPosicionado quer uma leitura de agora
+  aquisicao.esvaziar();
+}
+
+// Robô foi tirado do lugar e está parado de novo na posição de largada?
+bool roboPosicionado(unsigned long agora) {
+  float cm = CalibracaoPotencia::cm(aquisicao.lerMedia());
+
+  // Movimento só conta se a leitura ficar longe da posição final por
+  // TEMPO_MOVIMENTO_MS seguidos (uma amostra ruim não basta)
+  if (fabs(cm - distReferencia) > LIMIAR_MOVIMENTO_CM) {
+    if (!fora) {
+      fora = true;
+      inicioFora = agora;
+    }
+    if (agora - inicioFora >= TEMPO_MOVIMENTO_MS) viuMovimento = true;
+  } else {
+    fora = false;
+  }
+
+  if (cm < janelaMin) janelaMin = cm;
+  if (cm > janelaMax) janelaMax = cm;
+  if (janelaMax - janelaMin > TOLERANCIA_PARADO_CM ||
+      fabs(cm - DIST_LARGADA_CM) > FAIXA_LARGADA_CM) {
+    // Mexeu ou não está na largada: recomeça a janela de estabilidade
+    janelaMin = janelaMax = cm;
+    inicioJanela = agora;
+  }
+
+  return viuMovimento && (agora - inicioJanela >= TEMPO_PARADO_MS);
+}
+
+// Comandos de diagnóstico pelo Serial: 'm' imprime as métricas, 'z' zera.
+// Não é chamado na EXECUCAO (imprimir tudo atrasaria o controle).
+void atenderSerial() {
+  while (Serial.available()) {
+    char comando = Serial.read();
+    if (comando == 'm') metricas.imprimir(aquisicao.getDescartes());
+    else if (comando == 'z') {
+      metricas.zerar();
+      Serial.println(F("Metricas zeradas."));
+    }
+  }
+}
+
+// Treino acabou: para tudo e só pisca (métricas continuam consultáveis)
+void fimDoTreino() {
+  pararMotores();
+  Serial.println(F("FIM DO TREINO!"));
+  otimizador->imprimirStatus();
+  while(1) { piscarLed(2000); atenderSerial(); }
+}
+
+#if MODO_BENCHMARK
+#include "Benchmark.h"
+#endif
+
 // --- SETUP ---
 void setup() {
   Serial.begin(115200);
+  metricas.zerar(); // Substituídas pelas do checkpoint, se houver
   
   // Configura Pinos
   pinMode(PIN_ESQ_PWM, OUTPUT); pinMode(PIN_ESQ_GND, OUTPUT);
@@ -108,6 +238,9 @@ void setup() {
   }
   Serial.println(F("OK."));
 
+  // ADC em modo contínuo no sensor (substitui o analogRead)
+  aquisicao.iniciar(PIN_SENSOR);
+
   // Configura Algoritmos
   otimizador = new De();   // Cérebro
   custo = new CustoITAE();   // Juiz
@@ -116,43 +249,81 @@ void setup() {
   if (!otimizador->carregarEstado()) {
     otimizador->inicializar(); 
   }
+  metricas.contar(CONT_BOOT);
+
+#if FIM_POR_BOTAO
+  pinMode(PIN_BOTAO, INPUT_PULLUP);
+#endif
 
   // Reseta os dados do cartão SD!! CUIDADO!!!
   // otimizador->apagarDados();
 
-  estadoAtual = CONTAGEM;
-  tempoInicioEstado = millis();
+#if MODO_BENCHMARK
+  rodarBenchmark();
+  while(1) piscarLed(1000);
+#endif
+
+  // Reboot depois do fim: não roda mais nenhuma avaliação
+  if (otimizador->isConcluido()) fimDoTreino();
+
+  // A cada boot: um log continuado depois de regravar o firmware fica marcado
+  otimizador->anotarConvergencia(F("filtro=" FILTRO_TREINO));
+
+  // O candidato não vai no checkpoint antigo: gera e salva durante a contagem
+  iniciarContagem(TAREFA_CANDIDATO | TAREFA_ESTADO);
 }
 
 // --- LOOP ---
 void loop() {
+  if (estadoAtual != EXECUCAO) atenderSerial();
+
   switch (estadoAtual) {
     
     // 1. CONTAGEM (Reposicionamento)
     case CONTAGEM:
     {
-      unsigned long decorrido = millis() - tempoInicioEstado;
-      
-      if (decorrido < 7000) piscarLed(500);       // 0-7s: Pisca Lento (Posicione)
-      else if (decorrido < 10000) piscarLed(100); // 7-10s: Pisca Rápido (Solte!)
+      if (tarefasPendentes) executarTarefa();
+
+      unsigned long agora = millis();
+      bool emAviso = (long)(agora - (fimContagem - TEMPO_AVISO_MS)) >= 0;
+
+      if (!emAviso) {
+        bool posicionado = false;
+#if FIM_POR_BOTAO
+        posicionado |= (digitalRead(PIN_BOTAO) == LOW);
+#endif
+#if FIM_POR_SENSOR
+        posicionado |= roboPosicionado(agora);
+#endif
+        if (posicionado) {
+          fimContagem = agora + TEMPO_AVISO_MS; // Pula direto para o aviso
+          emAviso = true;
+        }
+      }
+
+      if (!emAviso) piscarLed(500);                                           // Pisca Lento (Posicione)
+      else if ((long)(agora - fimContagem) < 0 || tarefasPendentes) piscarLed(100); // Pisca Rápido (Solte!)
       else {
         digitalWrite(PIN_LED, HIGH); // Aceso = Valendo!
         
         // Reset para nova rodada
-        erroAnterior = 0; integralErro = 0;
+        pid.reset();
         custo->reset();
+        passosRodada = 0;
 
         // REINICIALIZA O FILTRO COM UMA LEITURA ATUAL
         // Isso evita que ele comece tentando convergir do zero
-        float leituraInicial = 10650.08 * pow(analogRead(PIN_SENSOR), -0.935) - 10;
+        aquisicao.esvaziar(); // Nada leu o anel durante o aviso: começa do bloco de agora
+        float leituraInicial = CalibracaoPotencia::cm(aquisicao.lerMedia());
         filtroDist.setEstimate(leituraInicial);
+        metricas.contar(CONT_KALMAN_RESET);
         
-        otimizador->getParametrosAtuais(Kp, Ki, Kd); // Pega novos Kp, Ki, Kd
+        otimizador->getParametrosAtuais(pid.ganhos.Kp, pid.ganhos.Ki, pid.ganhos.Kd); // Pega novos Kp, Ki, Kd
         
         Serial.print(F("Rodando Particula... PID: "));
-        Serial.print(Kp); Serial.print(F(" ")); Serial.print(Ki); Serial.print(F(" ")); Serial.println(Kd);
+        Serial.print(pid.ganhos.Kp); Serial.print(F(" ")); Serial.print(pid.ganhos.Ki); Serial.print(F(" ")); Serial.println(pid.ganhos.Kd);
         
-        estadoAtual = EXECUCAO;
+        trocarEstado(EXECUCAO);
         tempoInicioEstado = millis();
       }
       break;
@@ -163,10 +334,11 @@ void loop() {
     {
       if (millis() - tempoInicioEstado > TEMPO_DE_EXECUCAO_MS) {
         pararMotores();
-        estadoAtual = AVALIACAO;
+        trocarEstado(AVALIACAO);
         break;
       }
 
+      passosRodada++;
       dist = lerDistancia();
       Serial.print(F("Distância: "));
       Serial.print(dist, 4);
@@ -177,35 +349,15 @@ void loop() {
       custo->acumular(erro, millis() - tempoInicioEstado);
 
       // --- CÁLCULO PID ---
-      float P = Kp * erro;
-      
-      integralErro += erro;
-      if(integralErro > 50) integralErro = 50; // Anti-windup
-      if(integralErro < -50) integralErro = -50;
-      float I = Ki * integralErro;
-      
-      float D = Kd * (erro - erroAnterior);
-      erroAnterior = erro;
-      
-      pid_out = P + I + D;
-      // Serial.print("PID: ");
-      // Serial.print(pid_out);
-      // Serial.print(" | P: ");
-      // Serial.print(P);
-      // Serial.print(" | I: ");
-      // Serial.print(I);
-      // Serial.print(" | D: ");
-      // Serial.print(D);
-      // Serial.print(" | Erro: ");
-      // Serial.print(erro);
-      // Serial.print("\n");
+      // D usa a velocidade do filtro: d(erro)/dt = -d(dist)/dt
+      pid_out = pid.calcular(erro, -filtroDist.getVelocidade());
 
       acionarMotores(pid_out);
       
       // Log para Excel (A cada 50ms para não travar o SD)
       static unsigned long ultimoLog = 0;
       if (millis() - ultimoLog > 50) {
-        otimizador->salvarLog(dist, pid_out, erro);
+        otimizador->salvarLog(dist, pid_out, erro, passosRodada);
         ultimoLog = millis();
       }
       
@@ -223,21 +375,13 @@ void loop() {
       otimizador->proximaParticula();         // Prepara próxima
       
       if (otimizador->isConcluido()) {
-        Serial.println(F("FIM DO TREINO!"));
-        while(1) piscarLed(2000);
+        otimizador->salvarEstado();
+        otimizador->salvarConvergencia();
+        fimDoTreino();
       }
       
-      estadoAtual = SALVAMENTO;
-      break;
-    }
-
-    // 4. CHECKPOINT (Salva tudo)
-    case SALVAMENTO:
-    {
-      otimizador->salvarEstado(); // Salva binário (cérebro)
-      otimizador->salvarConvergencia(); // Salva a convergência
-      estadoAtual = CONTAGEM;     // Volta para o começo
-      tempoInicioEstado = millis();
+      // Checkpoint e próximo candidato rodam durante a contagem
+      iniciarContagem(TAREFA_CANDIDATO | TAREFA_ESTADO | TAREFA_CONVERGENCIA);
       break;
     }
   }
@@ -0,0 +1,79 @@
+#include "Aquisicao.h"
+
+// Instância única: a ISR do ADC precisa de um objeto global.
+// (dot_a_linkage no library.properties: só entra no binário quem usar)
+AquisicaoAdc aquisicao;
+
+ISR(ADC_vect) {
+    aquisicao._novaAmostra(ADC);
+}
+
+void AquisicaoAdc::iniciar(uint8_t pino) {
+    if (pino >= A0) pino -= A0;
+
+    noInterrupts();
+    cabeca = 0;
+    cauda = 0;
+    descartes = 0;
+    transbordou = 0;
+    perdidos = 0;
+    blocosSemLeitura = 0;
+    soma = 0;
+    amostras = 0;
+    interrupts();
+
+    ADMUX = _BV(REFS0) | (pino & 0x07);       // Referência AVcc (igual ao analogRead)
+    ADCSRB = 0;                               // Gatilho: free-running
+    ADCSRA = _BV(ADEN) | _BV(ADATE) | _BV(ADIE) |
+             _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0); // Prescaler 128 -> 125kHz
+    ADCSRA |= _BV(ADSC);                      // Primeira conversão dispara o ciclo
+}
+
+void AquisicaoAdc::parar() {
+    // Devolve o ADC no modo que o analogRead() espera
+    ADCSRA = _BV(ADEN) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+}
+
+void AquisicaoAdc::esvaziar() {
+    noInterrupts();
+    cauda = cabeca;
+    transbordou = 0;
+    perdidos = 0;
+    blocosSemLeitura = 0;
+    uint16_t bloco = ultimoBloco;
+    interrupts();
+
+    ultimaMedia = (bloco + AQUISICAO_AMOSTRAS_POR_BLOCO / 2) / AQUISICAO_AMOSTRAS_POR_BLOCO;
+}
+
+int AquisicaoAdc::lerMedia() {
+    if (transbordou) {
+        noInterrupts();
+        if (blocosSemLeitura <= AQUISICAO_LIMITE_OCIOSO) descartes += perdidos;
+        interrupts();
+        esvaziar();
+        return ultimaMedia;
+    }
+    blocosSemLeitura = 0;
+
+    uint8_t fim = cabeca; // Leitura de 1 byte: atômica
+    uint8_t i = cauda;
+    if (i == fim) return ultimaMedia;
+
+    uint32_t total = 0;
+    uint8_t blocos = 0;
+    while (i != fim) {
+        total += anel[i];
+        i = (i + 1) & (AQUISICAO_TAMANHO_ANEL - 1);
+        blocos++;
+    }
+    cauda = fim; // Libera os blocos para a ISR
+
+    uint16_t n = (uint16_t)blocos * AQUISICAO_AMOSTRAS_POR_BLOCO;
+    ultimaMedia = (int)((total + n / 2) / n);
+    return ultimaMedia;
+}
+
+uint16_t AquisicaoAdc::getDescartes() {
+    return descartes;
+}
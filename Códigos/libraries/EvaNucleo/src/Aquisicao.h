@@ -0,0 +1,86 @@
+#ifndef AQUISICAO_H
+#define AQUISICAO_H
+
+#include <Arduino.h>
+
+// --- AQUISIÇÃO DO SENSOR POR INTERRUPÇÃO ---
+// O ADC roda sozinho (free-running, prescaler 128 -> ~9600 amostras/s) e a
+// ISR soma AQUISICAO_AMOSTRAS_POR_BLOCO amostras antes de publicar um bloco
+// no anel. O laço de controle só lê o anel: nunca espera o ADC (o
+// analogRead() bloqueava ~110us por ciclo).
+//
+// O anel é de um produtor (ISR) e um consumidor (loop), sem trava: a ISR só
+// escreve a cabeça e o loop só escreve a cauda, ambas de 1 byte (atômicas no
+// AVR). Anel cheio -> o bloco novo fica fora do anel, mas a ISR guarda sempre
+// o último bloco: depois de um transbordo o lerMedia() devolve esse, e não os
+// blocos velhos parados no anel.
+//
+// Descartes só contam se o leitor voltar a ler em menos de
+// AQUISICAO_LIMITE_OCIOSO blocos: um SD travando a EXECUCAO é perda, um loop
+// que parou de ler de propósito (aviso da contagem) não é. Pausas mais curtas
+// e propositais (gravações da contagem) chamam esvaziar() logo depois.
+//
+// Enquanto a aquisição está ligada, NÃO use analogRead() (ele reprograma o ADC).
+
+#define AQUISICAO_AMOSTRAS_POR_BLOCO 16 // Sobreamostragem (16 * 1023 cabe em 16 bits)
+#define AQUISICAO_TAMANHO_ANEL       16 // Potência de 2 (~26ms de folga)
+#define AQUISICAO_LIMITE_OCIOSO      64 // Blocos sem leitura (~107ms) = leitor ocioso (< 255)
+
+class AquisicaoAdc {
+private:
+    volatile uint16_t anel[AQUISICAO_TAMANHO_ANEL]; // Soma de cada bloco
+    volatile uint8_t cabeca = 0; // Escrita só pela ISR
+    volatile uint8_t cauda = 0;  // Escrita só pelo loop
+    uint16_t descartes = 0;                  // Só o loop escreve
+    volatile uint8_t perdidos = 0;           // Blocos fora do anel desde o transbordo
+    volatile uint16_t ultimoBloco = 0;       // Sempre o mais novo, mesmo com anel cheio
+    volatile uint8_t transbordou = 0;        // Anel encheu: o conteúdo dele está velho
+    volatile uint8_t blocosSemLeitura = 0;   // Zerado a cada lerMedia()
+
+    // Acumulador do bloco em andamento (só a ISR mexe)
+    uint16_t soma = 0;
+    uint8_t amostras = 0;
+
+    int ultimaMedia = 0;
+
+public:
+    // pino: A0..A7
+    void iniciar(uint8_t pino);
+    void parar();
+
+    // Média dos blocos que chegaram desde a última chamada, na mesma escala
+    // do analogRead() (0..1023). Sem bloco novo, devolve a média anterior.
+    // Se o anel transbordou, devolve só o último bloco (o resto está velho).
+    int lerMedia();
+
+    // Joga fora o que está no anel e começa do último bloco. Use antes de uma
+    // leitura que precisa ser de agora, depois de um tempo sem ler.
+    void esvaziar();
+
+    // Blocos perdidos por anel cheio com o leitor ativo (ex.: SD travando o loop)
+    uint16_t getDescartes();
+
+    // Uso interno da ISR(ADC_vect)
+    void _novaAmostra(uint16_t valor) {
+        soma += valor;
+        if (++amostras < AQUISICAO_AMOSTRAS_POR_BLOCO) return;
+
+        ultimoBloco = soma;
+        if (blocosSemLeitura < 255) blocosSemLeitura++;
+
+        uint8_t proxima = (cabeca + 1) & (AQUISICAO_TAMANHO_ANEL - 1);
+        if (proxima == cauda) {
+            transbordou = 1;
+            if (perdidos < 255) perdidos++;
+        } else {
+            anel[cabeca] = soma;
+            cabeca = proxima;
+        }
+        soma = 0;
+        amostras = 0;
+    }
+};
+
+extern AquisicaoAdc aquisicao;
+
+#endif
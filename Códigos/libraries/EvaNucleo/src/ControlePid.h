@@ -0,0 +1,57 @@
+#ifndef CONTROLE_PID_H
+#define CONTROLE_PID_H
+
+// --- GANHOS DO PID ---
+// O controlador é especializado no tipo dos ganhos. Todo tipo de ganhos expõe:
+//   kp(), ki(), kd()     -> ganhos discretos (por amostra)
+//   limiteIntegral()     -> saturação do acumulador (anti-windup)
+// Se forem static constexpr, o compilador dobra as contas (eva-pid).
+// Se forem membros, o otimizador pode trocá-los a cada rodada (eva).
+
+// Ganhos trocados em tempo de execução pelo Otimizador
+struct GanhosVariaveis {
+    float Kp = 0, Ki = 0, Kd = 0;
+
+    float kp() const { return Kp; }
+    float ki() const { return Ki; }
+    float kd() const { return Kd; }
+    static constexpr float limiteIntegral() { return 50.0f; }
+};
+
+template <class Ganhos>
+class ControlePid {
+private:
+    float erroAnterior = 0;
+    float integralErro = 0;
+
+public:
+    Ganhos ganhos;
+
+    void reset() {
+        erroAnterior = 0;
+        integralErro = 0;
+    }
+
+    // D pela diferença finita do erro
+    float calcular(float erro) {
+        float derivada = erro - erroAnterior;
+        erroAnterior = erro;
+        return calcular(erro, derivada);
+    }
+
+    // D por uma derivada já filtrada (ex.: KalmanVelocidade), em erro/amostra
+    float calcular(float erro, float derivadaErro) {
+        float P = ganhos.kp() * erro;
+
+        integralErro += erro;
+        if (integralErro > ganhos.limiteIntegral()) integralErro = ganhos.limiteIntegral(); // Anti-windup
+        if (integralErro < -ganhos.limiteIntegral()) integralErro = -ganhos.limiteIntegral();
+        float I = ganhos.ki() * integralErro;
+
+        float D = ganhos.kd() * derivadaErro;
+
+        return P + I + D;
+    }
+};
+
+#endif
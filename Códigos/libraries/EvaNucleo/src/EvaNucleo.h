@@ -0,0 +1,13 @@
+#ifndef EVA_NUCLEO_H
+#define EVA_NUCLEO_H
+
+// Núcleo compartilhado entre os sketches eva (treino) e eva-pid (implantação).
+// Para o Arduino IDE encontrar esta biblioteca, aponte o "Local do Sketchbook"
+// para a pasta Códigos/ (ou copie libraries/EvaNucleo para o seu sketchbook).
+
+#include "Sensor.h"
+#include "Aquisicao.h"
+#include "FiltroKalman.h"
+#include "ControlePid.h"
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef FILTRO_KALMAN_H
+#define FILTRO_KALMAN_H
+
+// --- COEFICIENTES DO FILTRO ---
+// O filtro recebe os coeficientes como TIPO (funções static constexpr),
+// assim o compilador dobra as constantes direto no código de máquina.
+// (IncertezaMedicao, IncertezaEstimativa, RuidoProcesso)
+struct CoefKalmanPadrao {
+    static constexpr float erroMedicao()    { return 4.0f; }
+    static constexpr float erroEstimativa() { return 2.0f; }
+    static constexpr float ruidoProcesso()  { return 0.3f; }
+    static constexpr float ruidoAceleracao() { return 0.1f; } // cm/amostra² (KalmanVelocidade)
+};
+
+// Raiz quadrada avaliada na compilação (Newton), para os ganhos estacionários
+constexpr float passoRaizNewton(float x, float r, int n) {
+    return (n == 0) ? r : passoRaizNewton(x, 0.5f * (r + x / r), n - 1);
+}
+constexpr float raizConstexpr(float x) {
+    return (x <= 0) ? 0 : passoRaizNewton(x, (x > 1) ? x : 1.0f, 24);
+}
+
+// --- INÍCIO DA CLASSE KALMAN FILTER ---
+template <class Coef>
+class SimpleKalmanFilter {
+  private:
+    float _err_estimate = Coef::erroEstimativa();
+    float _current_estimate = 0;
+    float _last_estimate = 0;
+    float _kalman_gain = 0;
+
+  public:
+    float updateEstimate(float mea) {
+      _kalman_gain = _err_estimate / (_err_estimate + Coef::erroMedicao());
+      _current_estimate = _last_estimate + _kalman_gain * (mea - _last_estimate);
+      _err_estimate =  (1.0f - _kalman_gain) * _err_estimate + _fabs(_last_estimate - _current_estimate) * Coef::ruidoProcesso();
+      _last_estimate = _current_estimate;
+
+      return _current_estimate;
+    }
+
+    void setEstimate(float est) {
+      _current_estimate = est;
+      _last_estimate = est;
+    }
+
+    // Auxiliar para valor absoluto float (para economizar lib math se precisar)
+    static float _fabs(float x) { return (x >= 0) ? x : -x; }
+};
+// --- FIM DA CLASSE KALMAN FILTER ---
+
+// --- KALMAN ESTACIONÁRIO (1 ESTADO: DISTÂNCIA) ---
+// Modelo de passeio aleatório com Q = ruidoProcesso e R = erroMedicao.
+// A variância converge para a solução da equação de Riccati:
+//   P- = (Q + sqrt(Q² + 4QR)) / 2      K = P- / (P- + R)
+// K é calculado na compilação: a atualização é uma multiplicação, sem divisão.
+template <class Coef>
+class KalmanEstacionario {
+  private:
+    float _estimate = 0;
+
+  public:
+    static constexpr float P_PRIORI = 0.5f * (Coef::ruidoProcesso() +
+        raizConstexpr(Coef::ruidoProcesso() * Coef::ruidoProcesso() + 4.0f * Coef::ruidoProcesso() * Coef::erroMedicao()));
+    static constexpr float GANHO = P_PRIORI / (P_PRIORI + Coef::erroMedicao());
+
+    float updateEstimate(float mea) {
+      _estimate += GANHO * (mea - _estimate);
+      return _estimate;
+    }
+
+    void setEstimate(float est) { _estimate = est; }
+};
+
+template <class Coef> constexpr float KalmanEstacionario<Coef>::P_PRIORI;
+template <class Coef> constexpr float KalmanEstacionario<Coef>::GANHO;
+
+// --- KALMAN ESTACIONÁRIO (2 ESTADOS: DISTÂNCIA E VELOCIDADE) ---
+// Modelo de velocidade constante, período = 1 amostra. Em regime o Kalman
+// vira um filtro alfa-beta; os ganhos saem do índice de rastreamento
+//   L = ruidoAceleracao / sqrt(erroMedicao)            (Kalata, 1984)
+//   alfa = -(L² + 8L - (L + 4) sqrt(L² + 8L)) / 8
+//   beta = (L² + 4L - L sqrt(L² + 8L)) / 4
+// A velocidade sai em cm/amostra, na mesma escala da diferença
+// erro - erroAnterior que o PID usava no termo D.
+template <class Coef>
+class KalmanVelocidade {
+  private:
+    float _estimate = 0;
+    float _velocidade = 0;
+
+  public:
+    static constexpr float INDICE = Coef::ruidoAceleracao() / raizConstexpr(Coef::erroMedicao());
+    static constexpr float RAIZ = raizConstexpr(INDICE * INDICE + 8.0f * INDICE);
+    static constexpr float ALFA = -(INDICE * INDICE + 8.0f * INDICE - (INDICE + 4.0f) * RAIZ) / 8.0f;
+    static constexpr float BETA = (INDICE * INDICE + 4.0f * INDICE - INDICE * RAIZ) / 4.0f;
+
+    float updateEstimate(float mea) {
+      float previsto = _estimate + _velocidade;
+      float residuo = mea - previsto;
+      _estimate = previsto + ALFA * residuo;
+      _velocidade += BETA * residuo;
+      return _estimate;
+    }
+
+    // Derivada da distância filtrada (cm/amostra)
+    float getVelocidade() const { return _velocidade; }
+
+    void setEstimate(float est) {
+      _estimate = est;
+      _velocidade = 0;
+    }
+};
+
+template <class Coef> constexpr float KalmanVelocidade<Coef>::INDICE;
+template <class Coef> constexpr float KalmanVelocidade<Coef>::RAIZ;
+template <class Coef> constexpr float KalmanVelocidade<Coef>::ALFA;
+template <class Coef> constexpr float KalmanVelocidade<Coef>::BETA;
+
+#endif
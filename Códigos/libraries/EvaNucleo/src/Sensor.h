@@ -0,0 +1,41 @@
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include <Arduino.h>
+#include <math.h>
+
+// --- LIMITES FÍSICOS DA PISTA ---
+#define DIST_MIN_CM 40
+#define DIST_MAX_CM 90
+
+// --- CALIBRAÇÃO DO SENSOR IR ---
+// Toda calibração expõe: static float cm(int leitura)
+
+// Equação calibrada em tempo de execução (usada no treino).
+// Custa um pow() em float por amostra.
+struct CalibracaoPotencia {
+    static float cm(int leitura) {
+        return 10650.08 * pow(leitura, -0.935) - 10;
+    }
+};
+
+// Equação já avaliada e saturada em [DIST_MIN_CM, DIST_MAX_CM].
+// A tabela fica na flash (PROGMEM) e cobre apenas as leituras do ADC em que
+// a equação cai dentro dos limites; fora dela o valor é o da ponta.
+// Gerada por Ferramentas/gerador_sintonia.py (ver Sintonia.h do eva-pid).
+template <int LEITURA_MIN, int LEITURA_MAX, const float* TABELA>
+struct CalibracaoTabela {
+    static float cm(int leitura) {
+        if (leitura < LEITURA_MIN) leitura = LEITURA_MIN;
+        if (leitura > LEITURA_MAX) leitura = LEITURA_MAX;
+        return pgm_read_float(&TABELA[leitura - LEITURA_MIN]);
+    }
+};
+
+inline float limitarDistancia(float cm) {
+    if (cm < DIST_MIN_CM) cm = DIST_MIN_CM;
+    if (cm > DIST_MAX_CM) cm = DIST_MAX_CM;
+    return cm;
+}
+
+#endif
@@ -0,0 +1,639 @@
+// --- ANÁLISE DOS LOGS DOS EXPERIMENTOS ---
+// Substitui o parse do gerador_de_grafico.py nos logs grandes. Mapeia na
+// memória (mmap) os DADOS.txt / CONVERG.txt / DE_DADOS.txt / DE_CONV.txt de
+// todas as pastas exp* e lê os campos sem copiar, pelo NOME da coluna no
+// cabeçalho (aceita os nomes antigos e novos: Iteracao/Ger, Erro_Atual/Erro...).
+// As pastas são processadas em paralelo.
+//
+// Linhas que não batem com o cabeçalho NÃO somem em silêncio: são contadas em
+// analise_arquivos.csv. Linhas que perderam a quebra (N registros colados na
+// mesma linha, como no exp1/CONVERG.txt) são separadas de volta.
+//
+// Saída (CSV) em <raiz>/analise/:
+//   analise_arquivos.csv     linhas, registros, linhas descartadas e rodadas suspeitas por arquivo
+//   analise_execucoes.csv    uma linha por rodada (partícula testada): ITAE, IAE, RMS, acomodação
+//   analise_iteracoes.csv    por iteração: melhor, média e desvio do ITAE das rodadas, gbest
+//   analise_particulas.csv   por partícula: melhor, média e desvio do ITAE
+//   analise_convergencia.csv por iteração: menor gbest registrado e seus Kp, Ki, Kd
+//
+// Uso: analise_logs [-o saida] [-f faixa_cm] [-d duracao_ms] [raiz]
+//   raiz        pasta com os exp* (padrão: .)
+//   -f          faixa de erro para considerar acomodado (padrão: 2 cm)
+//   -d          duração de cada rodada no robô (padrão: 10000 ms, TEMPO_DE_EXECUCAO_MS)
+//
+// O log não tem tempo: as amostras de uma rodada são espalhadas
+// uniformemente na duração da rodada. O ITAE aqui é a integral (cm·s²), não
+// a soma por ciclo do firmware, então só compare rodadas entre si.
+//
+// Rodadas com muito mais ou muito menos amostras que a mediana do arquivo
+// são marcadas em `suspeita` e ficam fora das médias por iteração/partícula:
+// "emendada" é a rodada interrompida por um reboot seguida da repetição dela
+// (mesma iteração e partícula, sem nada no log que as separe); "incompleta"
+// é uma rodada cortada. A base de tempo dessas rodadas está errada.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// --- ARQUIVO MAPEADO ---
+class ArquivoMapeado {
+private:
+    void* dados = nullptr;
+    size_t tamanho = 0;
+
+public:
+    explicit ArquivoMapeado(const fs::path& caminho) {
+        int fd = open(caminho.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            tamanho = (size_t)info.st_size;
+            dados = mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (dados == MAP_FAILED) {
+                dados = nullptr;
+                tamanho = 0;
+            } else {
+                madvise(dados, tamanho, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+    }
+
+    ~ArquivoMapeado() {
+        if (dados) munmap(dados, tamanho);
+    }
+
+    ArquivoMapeado(const ArquivoMapeado&) = delete;
+    ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+
+    std::string_view conteudo() const {
+        return dados ? std::string_view((const char*)dados, tamanho) : std::string_view();
+    }
+};
+
+// --- ESQUEMA PELO CABEÇALHO ---
+enum Campo {
+    CAMPO_ITERACAO, CAMPO_PARTICULA, CAMPO_DISTANCIA, CAMPO_PWM, CAMPO_ERRO,
+    CAMPO_GBEST, CAMPO_KP, CAMPO_KI, CAMPO_KD, CAMPO_DIVERSIDADE, CAMPO_DECISAO,
+    CAMPO_PASSO, // Inércia do PSO: gravada só em alguns experimentos
+    NUM_CAMPOS
+};
+
+struct Alias {
+    const char* nome;
+    Campo campo;
+};
+
+// Nomes já normalizados (minúsculas, sem espaços); "Iteração" chega como "iteração"
+static const Alias ALIASES[] = {
+    { "iteracao", CAMPO_ITERACAO }, { "iteração", CAMPO_ITERACAO },
+    { "ger", CAMPO_ITERACAO }, { "geracao", CAMPO_ITERACAO }, { "geração", CAMPO_ITERACAO },
+    { "particula", CAMPO_PARTICULA }, { "partícula", CAMPO_PARTICULA }, { "ind", CAMPO_PARTICULA },
+    { "distancia", CAMPO_DISTANCIA }, { "distância", CAMPO_DISTANCIA }, { "dist", CAMPO_DISTANCIA },
+    { "pwm", CAMPO_PWM },
+    { "erro_atual", CAMPO_ERRO }, { "erro", CAMPO_ERRO },
+    { "gbest_erro", CAMPO_GBEST },
+    { "kp", CAMPO_KP }, { "kp_best", CAMPO_KP },
+    { "ki", CAMPO_KI }, { "ki_best", CAMPO_KI },
+    { "kd", CAMPO_KD }, { "kd_best", CAMPO_KD },
+    { "diversidade", CAMPO_DIVERSIDADE },
+    { "decisao", CAMPO_DECISAO }, { "decisão", CAMPO_DECISAO },
+    { "passo", CAMPO_PASSO },
+};
+
+struct Esquema {
+    int coluna[NUM_CAMPOS]; // -1 = ausente
+    int largura = 0;        // Colunas no cabeçalho
+    int minimo = 0;         // Sem as colunas finais opcionais (só "Passo")
+    int maximo = 0;         // Com "Passo" no fim, mesmo se o cabeçalho não tiver
+
+    Esquema() { std::fill(coluna, coluna + NUM_CAMPOS, -1); }
+    bool tem(Campo c) const { return coluna[c] >= 0; }
+};
+
+static std::string_view aparar(std::string_view s) {
+    while (!s.empty() && (unsigned char)s.front() <= ' ') s.remove_prefix(1);
+    while (!s.empty() && (unsigned char)s.back() <= ' ') s.remove_suffix(1);
+    return s;
+}
+
+static void separar(std::string_view linha, std::vector<std::string_view>& campos) {
+    campos.clear();
+    size_t inicio = 0;
+    for (;;) {
+        size_t virgula = linha.find(',', inicio);
+        if (virgula == std::string_view::npos) {
+            campos.push_back(aparar(linha.substr(inicio)));
+            return;
+        }
+        campos.push_back(aparar(linha.substr(inicio, virgula - inicio)));
+        inicio = virgula + 1;
+    }
+}
+
+static bool lerNumero(std::string_view s, double& valor) {
+    if (s.empty()) return false;
+    const char* fim = s.data() + s.size();
+    auto resultado = std::from_chars(s.data(), fim, valor);
+    return resultado.ec == std::errc() && resultado.ptr == fim;
+}
+
+static bool ehCabecalho(const std::vector<std::string_view>& campos, Esquema& esquema) {
+    Esquema novo;
+    novo.largura = (int)campos.size();
+    int reconhecidos = 0;
+
+    for (int i = 0; i < (int)campos.size(); i++) {
+        std::string nome(campos[i]);
+        for (char& c : nome) c = (char)std::tolower((unsigned char)c);
+        for (const Alias& alias : ALIASES) {
+            if (nome == alias.nome && novo.coluna[alias.campo] < 0) {
+                novo.coluna[alias.campo] = i;
+                reconhecidos++;
+                break;
+            }
+        }
+    }
+    if (reconhecidos < 2 || !novo.tem(CAMPO_ITERACAO)) return false;
+
+    novo.minimo = novo.largura;
+    novo.maximo = novo.largura;
+    if (novo.coluna[CAMPO_PASSO] == novo.largura - 1) novo.minimo--;
+    else if (!novo.tem(CAMPO_PASSO)) novo.maximo++; // Firmware novo continuando um log antigo
+    esquema = novo;
+    return true;
+}
+
+// --- LEITURA DE UM LOG ---
+struct Registro {
+    double v[NUM_CAMPOS];
+    std::string_view decisao;
+};
+
+struct ResumoArquivo {
+    std::string experimento, arquivo;
+    long linhas = 0, registros = 0, malformadas = 0, suspeitas = 0;
+};
+
+// Chama `consumir(registro)` para cada registro válido. Linha mais curta que o
+// cabeçalho (fora a coluna opcional "Passo"), campos obrigatórios não
+// numéricos ou Iteracao/Particula não inteiras descartam o registro (e contam
+// em malformadas).
+template <class Consumidor>
+static void lerLog(const fs::path& caminho, const Campo* obrigatorios, int numObrigatorios,
+                   ResumoArquivo& resumo, Consumidor consumir) {
+    ArquivoMapeado arquivo(caminho);
+    std::string_view resto = arquivo.conteudo();
+
+    Esquema esquema;
+    bool temEsquema = false;
+    std::vector<std::string_view> campos;
+    campos.reserve(16);
+
+    while (!resto.empty()) {
+        size_t quebra = resto.find('\n');
+        std::string_view linha = resto.substr(0, quebra);
+        resto = (quebra == std::string_view::npos) ? std::string_view() : resto.substr(quebra + 1);
+
+        linha = aparar(linha);
+        if (linha.empty()) continue;
+        resumo.linhas++;
+        if (linha.front() == '#') continue; // Anotação do firmware (ex.: "# filtro=velocidade")
+
+        separar(linha, campos);
+
+        double primeiro;
+        if (!lerNumero(campos[0], primeiro)) {
+            // Cabeçalho: o firmware só grava com o arquivo vazio, mas um no
+            // meio (logs concatenados) troca o esquema dali em diante
+            if (ehCabecalho(campos, esquema)) temEsquema = true;
+            else resumo.malformadas++;
+            continue;
+        }
+        if (!temEsquema) {
+            resumo.malformadas++;
+            continue;
+        }
+
+        // Registros colados (quebra de linha perdida): divide pela largura
+        int largura = esquema.largura;
+        int total = (int)campos.size();
+        int blocos = 1;
+        if (total > esquema.maximo) {
+            while (total > largura && campos[total - 1].empty()) total--; // Vírgula final da colagem
+        }
+        if (total > esquema.maximo) {
+            if (total % largura != 0) {
+                resumo.malformadas++;
+                continue;
+            }
+            blocos = total / largura;
+        } else if (total >= esquema.minimo) {
+            largura = total; // Só a coluna final "Passo" pode faltar ou sobrar
+        } else {
+            resumo.malformadas++; // Campo perdido: as colunas estariam deslocadas
+            continue;
+        }
+
+        for (int b = 0; b < blocos; b++) {
+            int base = b * largura;
+            Registro registro;
+            bool valido = true;
+
+            for (int c = 0; c < NUM_CAMPOS; c++) {
+                registro.v[c] = NAN;
+                int coluna = esquema.coluna[c];
+                if (coluna < 0 || coluna >= largura || c == CAMPO_DECISAO) continue;
+                if (!lerNumero(campos[base + coluna], registro.v[c])) registro.v[c] = NAN;
+            }
+            for (int o = 0; o < numObrigatorios; o++) {
+                if (std::isnan(registro.v[obrigatorios[o]])) valido = false;
+            }
+            for (Campo id : { CAMPO_ITERACAO, CAMPO_PARTICULA }) {
+                double x = registro.v[id];
+                if (!std::isnan(x) && (x < 0 || x != std::floor(x))) valido = false;
+            }
+            int colunaDecisao = esquema.coluna[CAMPO_DECISAO];
+            registro.decisao = (colunaDecisao >= 0 && colunaDecisao < largura) ? campos[base + colunaDecisao]
+                                                                               : std::string_view();
+
+            if (!valido) {
+                resumo.malformadas++;
+                continue;
+            }
+            resumo.registros++;
+            consumir(registro);
+        }
+    }
+}
+
+// --- ESTATÍSTICAS ---
+struct Estatistica {
+    long n = 0;
+    double melhor = INFINITY, soma = 0, soma2 = 0;
+
+    void adicionar(double x) {
+        n++;
+        soma += x;
+        soma2 += x * x;
+        if (x < melhor) melhor = x;
+    }
+    double media() const { return n ? soma / n : NAN; }
+    double desvio() const {
+        if (n < 2) return 0;
+        double m = media();
+        return std::sqrt(std::max(0.0, soma2 / n - m * m));
+    }
+};
+
+struct Execucao {
+    int iteracao, particula;
+    long amostras;
+    double itae, iae_medio, rms, erro_final, t_acomodacao; // NAN = não acomodou
+    const char* suspeita = ""; // "", "emendada" ou "incompleta"
+};
+
+// Fora de [0,5; 1,5] x a mediana de amostras do arquivo = rodada suspeita
+#define FATOR_EMENDADA   1.5
+#define FATOR_INCOMPLETA 0.5
+
+static long marcarSuspeitas(std::vector<Execucao>& execucoes) {
+    if (execucoes.empty()) return 0;
+    std::vector<long> amostras;
+    for (const Execucao& e : execucoes) amostras.push_back(e.amostras);
+    std::nth_element(amostras.begin(), amostras.begin() + amostras.size() / 2, amostras.end());
+    double mediana = (double)amostras[amostras.size() / 2];
+
+    long suspeitas = 0;
+    for (Execucao& e : execucoes) {
+        if (e.amostras > mediana * FATOR_EMENDADA) e.suspeita = "emendada";
+        else if (e.amostras < mediana * FATOR_INCOMPLETA) e.suspeita = "incompleta";
+        else continue;
+        suspeitas++;
+    }
+    return suspeitas;
+}
+
+struct Convergencia {
+    long registros = 0;
+    double gbest = INFINITY, kp = NAN, ki = NAN, kd = NAN, diversidade = NAN;
+    std::string decisao;
+};
+
+struct Resultado {
+    std::string experimento;
+    std::vector<ResumoArquivo> arquivos;
+
+    struct Log {
+        std::string algoritmo;
+        std::vector<Execucao> execucoes;
+        std::map<int, double> gbestPorIteracao; // Último gbest visto no DADOS
+        std::map<int, Convergencia> convergencia;
+    };
+    std::vector<Log> logs;
+};
+
+struct Opcoes {
+    fs::path raiz = ".";
+    fs::path saida;
+    double faixa_cm = 2.0;
+    double duracao_ms = 10000;
+};
+
+// Acumula uma rodada (amostras consecutivas da mesma iteração/partícula)
+class AcumuladorExecucao {
+private:
+    std::vector<double> erros;
+    int iteracao = -1, particula = -1;
+
+public:
+    bool aberta() const { return !erros.empty(); }
+    bool mesma(int i, int p) const { return aberta() && i == iteracao && p == particula; }
+
+    void iniciar(int i, int p) {
+        erros.clear();
+        iteracao = i;
+        particula = p;
+    }
+    void adicionar(double erro) { erros.push_back(erro); }
+
+    Execucao fechar(const Opcoes& opcoes) {
+        Execucao e;
+        e.iteracao = iteracao;
+        e.particula = particula;
+        e.amostras = (long)erros.size();
+
+        double dt = opcoes.duracao_ms / 1000.0 / erros.size();
+        double itae = 0, iae = 0, quad = 0;
+        long ultimaFora = -1;
+        for (size_t k = 0; k < erros.size(); k++) {
+            double absoluto = std::fabs(erros[k]);
+            itae += (k * dt) * absoluto * dt;
+            iae += absoluto;
+            quad += erros[k] * erros[k];
+            if (absoluto > opcoes.faixa_cm) ultimaFora = (long)k;
+        }
+        e.itae = itae;
+        e.iae_medio = iae / erros.size();
+        e.rms = std::sqrt(quad / erros.size());
+        e.erro_final = erros.back();
+        e.t_acomodacao = (ultimaFora == (long)erros.size() - 1) ? NAN : (ultimaFora + 1) * dt;
+
+        erros.clear();
+        return e;
+    }
+};
+
+static bool nomeIgual(const std::string& a, const char* b) {
+    if (a.size() != strlen(b)) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (std::tolower((unsigned char)a[i]) != std::tolower((unsigned char)b[i])) return false;
+    }
+    return true;
+}
+
+static Resultado analisarExperimento(const fs::path& pasta, const Opcoes& opcoes) {
+    Resultado resultado;
+    resultado.experimento = pasta.filename().string();
+
+    // Pares (dados, convergência) por algoritmo; nomes do SD em qualquer caixa
+    struct Par { const char* algoritmo; const char* dados; const char* conv; };
+    static const Par PARES[] = {
+        { "PSO", "DADOS.txt", "CONVERG.txt" },
+        { "DE", "DE_DADOS.txt", "DE_CONV.txt" },
+    };
+
+    for (const Par& par : PARES) {
+        fs::path caminhoDados, caminhoConv;
+        for (const auto& entrada : fs::directory_iterator(pasta)) {
+            std::string nome = entrada.path().filename().string();
+            if (nomeIgual(nome, par.dados)) caminhoDados = entrada.path();
+            if (nomeIgual(nome, par.conv)) caminhoConv = entrada.path();
+        }
+        if (caminhoDados.empty() && caminhoConv.empty()) continue;
+
+        Resultado::Log log;
+        log.algoritmo = par.algoritmo;
+
+        if (!caminhoDados.empty()) {
+            ResumoArquivo resumo;
+            resumo.experimento = resultado.experimento;
+            resumo.arquivo = caminhoDados.filename().string();
+
+            static const Campo OBRIGATORIOS[] = { CAMPO_ITERACAO, CAMPO_PARTICULA, CAMPO_ERRO };
+            AcumuladorExecucao rodada;
+            lerLog(caminhoDados, OBRIGATORIOS, 3, resumo, [&](const Registro& r) {
+                int iteracao = (int)r.v[CAMPO_ITERACAO];
+                int particula = (int)r.v[CAMPO_PARTICULA];
+                if (!rodada.mesma(iteracao, particula)) {
+                    if (rodada.aberta()) log.execucoes.push_back(rodada.fechar(opcoes));
+                    rodada.iniciar(iteracao, particula);
+                }
+                rodada.adicionar(r.v[CAMPO_ERRO]);
+                if (!std::isnan(r.v[CAMPO_GBEST])) log.gbestPorIteracao[iteracao] = r.v[CAMPO_GBEST];
+            });
+            if (rodada.aberta()) log.execucoes.push_back(rodada.fechar(opcoes));
+            resumo.suspeitas = marcarSuspeitas(log.execucoes);
+            resultado.arquivos.push_back(resumo);
+        }
+
+        if (!caminhoConv.empty()) {
+            ResumoArquivo resumo;
+            resumo.experimento = resultado.experimento;
+            resumo.arquivo = caminhoConv.filename().string();
+
+            static const Campo OBRIGATORIOS[] = { CAMPO_ITERACAO, CAMPO_GBEST };
+            lerLog(caminhoConv, OBRIGATORIOS, 2, resumo, [&](const Registro& r) {
+                Convergencia& c = log.convergencia[(int)r.v[CAMPO_ITERACAO]];
+                c.registros++;
+                if (r.v[CAMPO_GBEST] < c.gbest) {
+                    c.gbest = r.v[CAMPO_GBEST];
+                    c.kp = r.v[CAMPO_KP];
+                    c.ki = r.v[CAMPO_KI];
+                    c.kd = r.v[CAMPO_KD];
+                }
+                if (!std::isnan(r.v[CAMPO_DIVERSIDADE])) c.diversidade = r.v[CAMPO_DIVERSIDADE];
+                if (!r.decisao.empty() && r.decisao != "-") c.decisao = std::string(r.decisao);
+            });
+            resultado.arquivos.push_back(resumo);
+        }
+
+        resultado.logs.push_back(std::move(log));
+    }
+    return resultado;
+}
+
+// --- SAÍDA ---
+static void escreverNumero(FILE* f, double x) {
+    if (std::isnan(x) || std::isinf(x)) fputc(',', f);
+    else fprintf(f, ",%.6g", x);
+}
+
+static FILE* abrirSaida(const Opcoes& opcoes, const char* nome, const char* cabecalho) {
+    fs::path caminho = opcoes.saida / nome;
+    FILE* f = fopen(caminho.c_str(), "w");
+    if (!f) {
+        fprintf(stderr, "ERRO: não foi possível criar '%s'.\n", caminho.c_str());
+        exit(1);
+    }
+    fprintf(f, "%s\n", cabecalho);
+    return f;
+}
+
+static void escreverResultados(const std::vector<Resultado>& resultados, const Opcoes& opcoes) {
+    FILE* arquivos = abrirSaida(opcoes, "analise_arquivos.csv", "experimento,arquivo,linhas,registros,malformadas,rodadas_suspeitas");
+    FILE* execucoes = abrirSaida(opcoes, "analise_execucoes.csv",
+        "experimento,algoritmo,iteracao,particula,amostras,itae,iae_medio,rms,erro_final,t_acomodacao_s,suspeita");
+    FILE* iteracoes = abrirSaida(opcoes, "analise_iteracoes.csv",
+        "experimento,algoritmo,iteracao,execucoes,melhor_itae,media_itae,desvio_itae,media_rms,gbest");
+    FILE* particulas = abrirSaida(opcoes, "analise_particulas.csv",
+        "experimento,algoritmo,particula,execucoes,melhor_itae,media_itae,desvio_itae");
+    FILE* convergencia = abrirSaida(opcoes, "analise_convergencia.csv",
+        "experimento,algoritmo,iteracao,registros,gbest,kp,ki,kd,diversidade,decisao");
+
+    for (const Resultado& r : resultados) {
+        for (const ResumoArquivo& a : r.arquivos) {
+            fprintf(arquivos, "%s,%s,%ld,%ld,%ld,%ld\n", a.experimento.c_str(), a.arquivo.c_str(),
+                    a.linhas, a.registros, a.malformadas, a.suspeitas);
+        }
+
+        for (const Resultado::Log& log : r.logs) {
+            const char* exp = r.experimento.c_str();
+            const char* alg = log.algoritmo.c_str();
+            std::map<int, Estatistica> porIteracao, porParticula;
+            std::map<int, double> rmsPorIteracao;
+
+            for (const Execucao& e : log.execucoes) {
+                fprintf(execucoes, "%s,%s,%d,%d,%ld", exp, alg, e.iteracao, e.particula, e.amostras);
+                escreverNumero(execucoes, e.itae);
+                escreverNumero(execucoes, e.iae_medio);
+                escreverNumero(execucoes, e.rms);
+                escreverNumero(execucoes, e.erro_final);
+                escreverNumero(execucoes, e.t_acomodacao);
+                fprintf(execucoes, ",%s\n", e.suspeita);
+                if (*e.suspeita) continue; // Fora das médias
+
+                porIteracao[e.iteracao].adicionar(e.itae);
+                porParticula[e.particula].adicionar(e.itae);
+                rmsPorIteracao[e.iteracao] += e.rms;
+            }
+
+            for (const auto& [iteracao, est] : porIteracao) {
+                fprintf(iteracoes, "%s,%s,%d,%ld", exp, alg, iteracao, est.n);
+                escreverNumero(iteracoes, est.melhor);
+                escreverNumero(iteracoes, est.media());
+                escreverNumero(iteracoes, est.desvio());
+                escreverNumero(iteracoes, rmsPorIteracao[iteracao] / est.n);
+                auto gbest = log.gbestPorIteracao.find(iteracao);
+                escreverNumero(iteracoes, gbest == log.gbestPorIteracao.end() ? NAN : gbest->second);
+                fputc('\n', iteracoes);
+            }
+
+            for (const auto& [particula, est] : porParticula) {
+                fprintf(particulas, "%s,%s,%d,%ld", exp, alg, particula, est.n);
+                escreverNumero(particulas, est.melhor);
+                escreverNumero(particulas, est.media());
+                escreverNumero(particulas, est.desvio());
+                fputc('\n', particulas);
+            }
+
+            for (const auto& [iteracao, c] : log.convergencia) {
+                fprintf(convergencia, "%s,%s,%d,%ld", exp, alg, iteracao, c.registros);
+                escreverNumero(convergencia, c.gbest);
+                escreverNumero(convergencia, c.kp);
+                escreverNumero(convergencia, c.ki);
+                escreverNumero(convergencia, c.kd);
+                escreverNumero(convergencia, c.diversidade);
+                fprintf(convergencia, ",%s\n", c.decisao.c_str());
+            }
+        }
+    }
+
+    fclose(arquivos);
+    fclose(execucoes);
+    fclose(iteracoes);
+    fclose(particulas);
+    fclose(convergencia);
+}
+
+static void uso() {
+    fprintf(stderr, "Uso: analise_logs [-o saida] [-f faixa_cm] [-d duracao_ms] [raiz]\n");
+    exit(1);
+}
+
+int main(int argc, char** argv) {
+    Opcoes opcoes;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-o" || arg == "-f" || arg == "-d") && i + 1 >= argc) uso();
+        if (arg == "-o") opcoes.saida = argv[++i];
+        else if (arg == "-f") opcoes.faixa_cm = atof(argv[++i]);
+        else if (arg == "-d") opcoes.duracao_ms = atof(argv[++i]);
+        else if (!arg.empty() && arg[0] == '-') uso();
+        else opcoes.raiz = arg;
+    }
+    if (opcoes.saida.empty()) opcoes.saida = opcoes.raiz / "analise";
+
+    std::vector<fs::path> pastas;
+    std::error_code erro;
+    for (const auto& entrada : fs::directory_iterator(opcoes.raiz, erro)) {
+        if (entrada.is_directory() && entrada.path().filename().string().rfind("exp", 0) == 0) {
+            pastas.push_back(entrada.path());
+        }
+    }
+    if (erro || pastas.empty()) {
+        fprintf(stderr, "ERRO: nenhuma pasta exp* em '%s'.\n", opcoes.raiz.c_str());
+        return 1;
+    }
+    std::sort(pastas.begin(), pastas.end());
+
+    // Uma pasta por vez em cada thread; cada thread escreve só no seu índice
+    std::vector<Resultado> resultados(pastas.size());
+    std::atomic<size_t> proxima(0);
+    unsigned numThreads = std::max(1u, std::min<unsigned>(std::thread::hardware_concurrency(), (unsigned)pastas.size()));
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < numThreads; t++) {
+        threads.emplace_back([&]() {
+            for (size_t i = proxima++; i < pastas.size(); i = proxima++) {
+                resultados[i] = analisarExperimento(pastas[i], opcoes);
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+
+    fs::create_directories(opcoes.saida, erro);
+    escreverResultados(resultados, opcoes);
+
+    printf("-" "-----------------------------\n");
+    printf("SUCESSO! %zu experimentos\n", resultados.size());
+    for (const Resultado& r : resultados) {
+        for (const ResumoArquivo& a : r.arquivos) {
+            printf("  %-10s %-14s %7ld registros", a.experimento.c_str(), a.arquivo.c_str(), a.registros);
+            if (a.malformadas) printf("  (%ld linhas descartadas)", a.malformadas);
+            if (a.suspeitas) printf("  (%ld rodadas suspeitas)", a.suspeitas);
+            printf("\n");
+        }
+    }
+    printf("Resultados em: %s\n", opcoes.saida.c_str());
+    printf("------------------------------\n");
+    return 0;
+}
@@ -0,0 +1,84 @@
+// --- MICRO-BENCHMARK DOS KERNELS (PC) ---
+// Mede em ns por chamada os kernels que rodam a cada ciclo de EXECUCAO:
+// calibração, filtros, PID e funções de custo. Mesmo CSV do MODO_BENCHMARK
+// do eva.ino (lá em ciclos de CPU do AVR):
+//   alvo,kernel,unidade,min,media,repeticoes
+// analogRead, Serial e SD só existem na placa: meça com o MODO_BENCHMARK.
+
+#include <Arduino.h>
+#include <EvaNucleo.h>
+#include "Sintonia.h"
+#include "Custos.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#define LOTE     100000 // Chamadas por medida
+#define MEDIDAS  15     // Medidas por kernel (min e média entre elas)
+#define ENTRADAS 1024   // Entradas pré-sorteadas (potência de 2)
+
+static volatile float sumidouro;
+static int leituras[ENTRADAS];
+static float distancias[ENTRADAS];
+
+template <class Kernel>
+static void medir(const char* nome, Kernel kernel) {
+    double minimo = 1e30, total = 0;
+
+    for (int m = 0; m < MEDIDAS; m++) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < LOTE; i++) kernel(i & (ENTRADAS - 1));
+        auto t1 = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / LOTE;
+        if (ns < minimo) minimo = ns;
+        total += ns;
+    }
+
+    printf("host,%s,ns,%.3f,%.3f,%d\n", nome, minimo, total / MEDIDAS, LOTE * MEDIDAS);
+}
+
+int main() {
+    // Leituras do ADC em torno do setpoint, com ruído
+    std::mt19937 gerador(42);
+    std::normal_distribution<float> ruido(0.0f, 6.0f);
+    for (int i = 0; i < ENTRADAS; i++) {
+        leituras[i] = 220 + (int)ruido(gerador);
+        distancias[i] = CalibracaoPotencia::cm(leituras[i]);
+    }
+
+    printf("alvo,kernel,unidade,min,media,repeticoes\n");
+
+    medir("vazio", [](int i) { sumidouro = distancias[i]; });
+
+    medir("calibracao_pow", [](int i) { sumidouro = CalibracaoPotencia::cm(leituras[i]); });
+    medir("calibracao_tabela", [](int i) { sumidouro = CalibracaoSintonia::cm(leituras[i]); });
+
+    SimpleKalmanFilter<CoefKalmanPadrao> kalmanSimples;
+    KalmanEstacionario<CoefKalmanPadrao> kalmanEstacionario;
+    KalmanVelocidade<CoefKalmanPadrao> kalmanVelocidade;
+    medir("kalman_simples", [&](int i) { sumidouro = kalmanSimples.updateEstimate(distancias[i]); });
+    medir("kalman_estacionario", [&](int i) { sumidouro = kalmanEstacionario.updateEstimate(distancias[i]); });
+    medir("kalman_velocidade", [&](int i) { sumidouro = kalmanVelocidade.updateEstimate(distancias[i]); });
+
+    ControlePid<GanhosVariaveis> pidVariavel;
+    pidVariavel.ganhos.Kp = 4.91f; pidVariavel.ganhos.Ki = 1.84f; pidVariavel.ganhos.Kd = 0.61f;
+    ControlePid<Sintonia> pidConstante;
+    medir("pid_variavel", [&](int i) { sumidouro = pidVariavel.calcular(65 - distancias[i]); });
+    medir("pid_constexpr", [&](int i) { sumidouro = pidConstante.calcular(65 - distancias[i]); });
+
+    CustoMSE mse;
+    CustoIAE iae;
+    CustoITAE itae;
+    FuncaoCusto* custos[] = { &mse, &iae, &itae };
+    for (FuncaoCusto* custo : custos) {
+        char nome[32];
+        snprintf(nome, sizeof(nome), "custo_%s", custo->getNome());
+        custo->reset();
+        medir(nome, [&](int i) { custo->acumular(65 - distancias[i], (unsigned long)i * 10); });
+        sumidouro = custo->getCustoFinal();
+    }
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+// --- BENCHMARK DOS OTIMIZADORES (PC) ---
+// Roda o Pso e o De do firmware (os mesmos .cpp do eva) em funções de teste
+// clássicas e numa planta simulada do robô, por várias sementes, e imprime a
+// curva "melhor até agora" por avaliação:
+//   algoritmo,funcao,avaliacao,mediana,media,q25,q75
+// Uso: bench_otimizadores [sementes]
+
+#include <Arduino.h>
+#include <EvaNucleo.h>
+#include "Pso.h"
+#include "De.h"
+#include "Custos.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#define SEMENTES_PADRAO 51
+#define AVALIACOES (NUM_PARTICULAS * MAX_ITERACOES)
+
+// --- FUNÇÕES DE TESTE ---
+// Os otimizadores buscam dentro dos limites do PID (config.h). Cada função
+// normaliza (Kp, Ki, Kd) para [0, 1]³ e desloca o ótimo para OTIMO.
+static const float OTIMO[NUM_DIMENSOES] = { 0.3f, 0.6f, 0.2f };
+
+static void normalizar(float kp, float ki, float kd, float u[NUM_DIMENSOES]) {
+    u[0] = (kp - KP_MIN) / (KP_MAX - KP_MIN) - OTIMO[0];
+    u[1] = (ki - KI_MIN) / (KI_MAX - KI_MIN) - OTIMO[1];
+    u[2] = (kd - KD_MIN) / (KD_MAX - KD_MIN) - OTIMO[2];
+}
+
+static float esfera(float kp, float ki, float kd, std::mt19937&) {
+    float u[NUM_DIMENSOES];
+    normalizar(kp, ki, kd, u);
+    float soma = 0;
+    for (int d = 0; d < NUM_DIMENSOES; d++) soma += u[d] * u[d];
+    return soma;
+}
+
+static float rosenbrock(float kp, float ki, float kd, std::mt19937&) {
+    float u[NUM_DIMENSOES];
+    normalizar(kp, ki, kd, u);
+    float soma = 0;
+    for (int d = 0; d < NUM_DIMENSOES - 1; d++) {
+        float x = 4 * u[d] + 1, y = 4 * u[d + 1] + 1; // Ótimo em (1, 1, 1)
+        soma += 100 * (y - x * x) * (y - x * x) + (1 - x) * (1 - x);
+    }
+    return soma;
+}
+
+static float rastrigin(float kp, float ki, float kd, std::mt19937&) {
+    float u[NUM_DIMENSOES];
+    normalizar(kp, ki, kd, u);
+    float soma = 10 * NUM_DIMENSOES;
+    for (int d = 0; d < NUM_DIMENSOES; d++) {
+        float z = 10.24f * u[d];
+        soma += z * z - 10 * cosf(2 * (float)M_PI * z);
+    }
+    return soma;
+}
+
+// --- PLANTA DO ROBÔ ---
+// Cinemática simplificada: a diferença de PWM entre as rodas gira o robô, o
+// ângulo volta sozinho ao paralelo (constante PLANTA_ALINHAMENTO_S) e muda a
+// distância à parede. Mesmo sensor ruidoso, filtro, PID e ITAE do eva.ino,
+// a 10ms por amostra durante 10s. Com os ganhos do exp5_de o ITAE fica na
+// casa de 10^4, como no robô.
+#define PLANTA_PERIODO_S   0.01f
+#define PLANTA_PASSOS      1000
+#define PLANTA_VELOCIDADE  30.0f   // cm/s
+#define PLANTA_GIRO        0.01f   // rad/s por unidade de PWM
+#define PLANTA_ALINHAMENTO_S 0.3f
+#define PLANTA_RUIDO_CM    1.5f
+#define PLANTA_DIST_INICIAL 45.0f
+
+static float plantaPid(float kp, float ki, float kd, std::mt19937& gerador) {
+    std::normal_distribution<float> ruido(0.0f, PLANTA_RUIDO_CM);
+
+    KalmanVelocidade<CoefKalmanPadrao> filtro;
+    ControlePid<GanhosVariaveis> pid;
+    pid.ganhos.Kp = kp; pid.ganhos.Ki = ki; pid.ganhos.Kd = kd;
+    CustoITAE custo;
+    custo.reset();
+
+    float dist = PLANTA_DIST_INICIAL, angulo = 0;
+    filtro.setEstimate(dist + ruido(gerador));
+
+    for (int k = 0; k < PLANTA_PASSOS; k++) {
+        float medida = limitarDistancia(filtro.updateEstimate(dist + ruido(gerador)));
+        float erro = 65 - medida;
+        custo.acumular(erro, (unsigned long)k * 10);
+
+        float u = pid.calcular(erro, -filtro.getVelocidade());
+        int pwmEsq = 125 + (int)u;
+        if (pwmEsq > 255) pwmEsq = 255;
+        if (pwmEsq < 0) pwmEsq = 0;
+
+        angulo += PLANTA_PERIODO_S * (PLANTA_GIRO * (pwmEsq - 125) - angulo / PLANTA_ALINHAMENTO_S);
+        if (angulo > 1.2f) angulo = 1.2f;
+        if (angulo < -1.2f) angulo = -1.2f;
+        dist += PLANTA_PERIODO_S * PLANTA_VELOCIDADE * sinf(angulo);
+    }
+    return custo.getCustoFinal();
+}
+
+typedef float (*Funcao)(float, float, float, std::mt19937&);
+
+struct Caso {
+    const char* nome;
+    Funcao funcao;
+};
+
+static const Caso CASOS[] = {
+    { "esfera", esfera },
+    { "rosenbrock", rosenbrock },
+    { "rastrigin", rastrigin },
+    { "planta_pid", plantaPid },
+};
+
+// Curva "melhor até agora" de uma execução completa do otimizador.
+// Se ele parar antes do orçamento, o melhor valor é repetido até o fim.
+static void executar(Otimizador* otimizador, Funcao funcao, unsigned long semente, float curva[AVALIACOES]) {
+    randomSeed(semente);
+    std::mt19937 gerador(semente);
+
+    otimizador->inicializar();
+
+    float melhor = 1e30f;
+    for (int a = 0; a < AVALIACOES; a++) {
+        if (!otimizador->isConcluido()) {
+            float kp, ki, kd;
+            otimizador->prepararCandidato();
+            otimizador->getParametrosAtuais(kp, ki, kd);
+            float custo = funcao(kp, ki, kd, gerador);
+            otimizador->setErroDaRodada(custo);
+            otimizador->proximaParticula();
+            if (custo < melhor) melhor = custo;
+        }
+        curva[a] = melhor;
+    }
+}
+
+static float quantil(std::vector<float>& valores, float q) {
+    size_t i = (size_t)(q * (valores.size() - 1) + 0.5f);
+    std::nth_element(valores.begin(), valores.begin() + i, valores.end());
+    return valores[i];
+}
+
+int main(int argc, char** argv) {
+    int sementes = (argc > 1) ? atoi(argv[1]) : SEMENTES_PADRAO;
+    if (sementes < 1) sementes = 1;
+
+    printf("algoritmo,funcao,avaliacao,mediana,media,q25,q75\n");
+
+    for (int algoritmo = 0; algoritmo < 2; algoritmo++) {
+        for (const Caso& caso : CASOS) {
+            std::vector<std::vector<float> > curvas(sementes, std::vector<float>(AVALIACOES));
+
+            for (int s = 0; s < sementes; s++) {
+                Otimizador* otimizador = (algoritmo == 0) ? (Otimizador*)new Pso() : (Otimizador*)new De();
+                executar(otimizador, caso.funcao, (unsigned long)s + 1, curvas[s].data());
+                delete otimizador;
+            }
+
+            std::vector<float> coluna(sementes);
+            for (int a = 0; a < AVALIACOES; a++) {
+                double soma = 0;
+                for (int s = 0; s < sementes; s++) {
+                    coluna[s] = curvas[s][a];
+                    soma += coluna[s];
+                }
+                float mediana = quantil(coluna, 0.5f);
+                float q25 = quantil(coluna, 0.25f);
+                float q75 = quantil(coluna, 0.75f);
+                printf("%s,%s,%d,%g,%g,%g,%g\n", (algoritmo == 0) ? "PSO" : "DE", caso.nome,
+                       a + 1, mediana, soma / sementes, q25, q75);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#ifndef ARDUINO_HOST_H
+#define ARDUINO_HOST_H
+
+// --- ARDUINO NO PC ---
+// O mínimo da API do Arduino para compilar Pso.cpp, De.cpp, Custos.h e o
+// EvaNucleo nativamente (benchmarks). Serial e SD não fazem nada.
+
+#include <math.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define PROGMEM
+#define A0 14
+
+class __FlashStringHelper;
+#define F(texto) (reinterpret_cast<const __FlashStringHelper*>(texto))
+
+inline float pgm_read_float(const float* endereco) { return *endereco; }
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+// random() do Arduino, mas com gerador próprio e semente controlável
+void randomSeed(unsigned long semente);
+long random(long maximo);
+long random(long minimo, long maximo);
+
+unsigned long millis();
+unsigned long micros();
+
+class Print {
+public:
+    template <class T> size_t print(const T&) { return 0; }
+    template <class T> size_t print(const T&, int) { return 0; }
+    template <class T> size_t println(const T&) { return 0; }
+    template <class T> size_t println(const T&, int) { return 0; }
+    size_t println() { return 0; }
+    size_t write(uint8_t) { return 1; }
+    size_t write(const uint8_t*, size_t tamanho) { return tamanho; }
+    int getWriteError() { return 0; }
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long) {}
+    void flush() {}
+    int available() { return 0; }
+    int read() { return -1; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef SD_HOST_H
+#define SD_HOST_H
+
+#include "Arduino.h"
+
+#define FILE_READ  0
+#define FILE_WRITE 1
+
+// Cartão ausente: todo open() falha, como um SD sem cartão.
+class File : public Print {
+public:
+    explicit operator bool() const { return false; }
+    void close() {}
+    unsigned long size() { return 0; }
+    int read(void*, size_t) { return 0; }
+};
+
+class SDClass {
+public:
+    bool begin(int) { return true; }
+    bool exists(const char*) { return false; }
+    bool remove(const char*) { return false; }
+    File open(const char*, int = FILE_READ) { return File(); }
+};
+
+extern SDClass SD;
+
+#endif
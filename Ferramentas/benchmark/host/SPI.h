@@ -0,0 +1 @@
+// SPI não é usado no PC
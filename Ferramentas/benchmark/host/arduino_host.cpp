@@ -0,0 +1,36 @@
+#include "Arduino.h"
+#include "SD.h"
+
+#include <chrono>
+#include <random>
+
+HardwareSerial Serial;
+SDClass SD;
+
+static std::mt19937 gerador(0);
+
+void randomSeed(unsigned long semente) {
+    gerador.seed(semente);
+}
+
+long random(long maximo) {
+    return random(0, maximo);
+}
+
+long random(long minimo, long maximo) {
+    if (maximo <= minimo) return minimo;
+    std::uniform_int_distribution<long> distribuicao(minimo, maximo - 1);
+    return distribuicao(gerador);
+}
+
+static const std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - inicio).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - inicio).count();
+}
@@ -25,35 +25,47 @@ def gerar_grafico():
         return
 
     # 2. Processamento Robusto dos Dados
-    # Substitui quebras de linha por vírgulas e separa tudo
-    tokens = conteudo.replace('\n', ',').split(',')
-    
-    # Filtra apenas o que é número, ignorando cabeçalhos de texto ou espaços vazios
-    valores_numericos = []
-    for token in tokens:
-        token = token.strip()
-        if not token: continue # Pula vazio
+    # Cada registro tem 5 colunas (Iteração, Erro, Kp, Ki, Kd); os logs novos
+    # têm também Diversidade e Decisao (7 colunas), que aqui são ignoradas.
+    # Linhas que perderam a quebra (vários registros colados) são separadas de
+    # volta pela largura; o resto é contado e avisado, nunca some em silêncio.
+    NUM_COLUNAS = 5
+    LARGURA_NOVA = 7
+
+    def numerico(token):
         try:
-            valores_numericos.append(float(token))
+            float(token)
+            return True
         except ValueError:
-            continue # Pula textos (ex: cabeçalhos antigos)
+            return False
+
+    dados_organizados = []
+    descartadas = 0
+    for linha in conteudo.split('\n'):
+        tokens = [t.strip() for t in linha.split(',')]
+        while tokens and not tokens[-1]: tokens.pop() # Vírgula final da colagem
+        if not tokens: continue # Pula vazio
+        if not numerico(tokens[0]): continue # Pula textos (cabeçalhos)
+
+        # Formato novo: a 7ª coluna (Decisao) nunca é número
+        if len(tokens) % LARGURA_NOVA == 0 and not any(
+                numerico(tokens[i]) for i in range(LARGURA_NOVA - 1, len(tokens), LARGURA_NOVA)):
+            registros = [tokens[i : i + NUM_COLUNAS] for i in range(0, len(tokens), LARGURA_NOVA)]
+        elif len(tokens) % NUM_COLUNAS == 0:
+            registros = [tokens[i : i + NUM_COLUNAS] for i in range(0, len(tokens), NUM_COLUNAS)]
+        else:
+            descartadas += 1
+            continue
+
+        for registro in registros:
+            if all(numerico(t) for t in registro):
+                dados_organizados.append([float(t) for t in registro])
+            else:
+                descartadas += 1
 
     # 3. Organizar em Colunas
-    # Sabemos que são 5 colunas: Iteração, Erro, Kp, Ki, Kd
-    NUM_COLUNAS = 5
-    
-    # Verifica se os dados estão completos
-    if len(valores_numericos) % NUM_COLUNAS != 0:
-        print(f"AVISO: O número de dados ({len(valores_numericos)}) não é múltiplo de {NUM_COLUNAS}.")
-        print("Cortando os últimos dados incompletos para evitar erro...")
-        sobra = len(valores_numericos) % NUM_COLUNAS
-        valores_numericos = valores_numericos[:-sobra]
-
-    # Remodelar a lista plana em uma lista de linhas
-    dados_organizados = [
-        valores_numericos[i : i + NUM_COLUNAS] 
-        for i in range(0, len(valores_numericos), NUM_COLUNAS)
-    ]
+    if descartadas:
+        print(f"AVISO: {descartadas} linha(s)/registro(s) mal formado(s) ignorado(s) em '{ARQUIVO_ENTRADA}'.")
 
     # Criar DataFrame
     colunas = ['Iteracao', 'Gbest_Erro', 'Kp', 'Ki', 'Kd']
@@ -0,0 +1,282 @@
+import os
+import sys
+
+# Gera o Códigos/eva-pid/Sintonia.h a partir do melhor resultado do treino.
+# Os ganhos, os coeficientes do Kalman e a calibração do sensor viram
+# constantes (constexpr / PROGMEM), e o EvaNucleo dobra tudo na compilação.
+
+ALGORITMO = "DE"
+PASTA = 'exp5_de'
+
+# --- CONFIGURAÇÃO ---
+# Caminhos relativos a esta pasta (Ferramentas/), de onde quer que se rode
+PASTA_FERRAMENTAS = os.path.dirname(os.path.abspath(__file__))
+ARQUIVO_ENTRADA = os.path.join(PASTA_FERRAMENTAS, PASTA, 'CONVERG.txt')
+ARQUIVO_DADOS = os.path.join(PASTA_FERRAMENTAS, PASTA, 'DADOS.txt')
+if ALGORITMO == "DE":
+    ARQUIVO_ENTRADA = os.path.join(PASTA_FERRAMENTAS, PASTA, 'DE_CONV.txt')
+    ARQUIVO_DADOS = os.path.join(PASTA_FERRAMENTAS, PASTA, 'DE_DADOS.txt')
+
+ARQUIVO_SAIDA = os.path.join(PASTA_FERRAMENTAS, '..', 'Códigos', 'eva-pid', 'Sintonia.h')
+
+# Período do laço no treino e no eva-pid.
+# Ki e Kd são por amostra: se o período muda, os ganhos são reescalados
+# para manter o mesmo comportamento em tempo contínuo.
+# O do treino sai do log de dados: o eva grava na coluna Passo quantas
+# passadas do laço a rodada já deu, e TEMPO_DE_EXECUCAO_MS / passadas é o
+# período (o delay(10) é só parte dele: leitura, Serial e SD somam o resto).
+# Logs anteriores à coluna usam PERIODO_TREINO_MS_SEM_PASSO.
+TEMPO_DE_EXECUCAO_MS = 10000.0  # O mesmo do eva.ino
+PERIODO_TREINO_MS_SEM_PASSO = 15.0  # Laço real medido no robô: ~14-17 ms
+PERIODO_CONTROLE_MS = 5.0
+LIMITE_INTEGRAL_TREINO = 50.0
+
+# Filtro de Kalman (IncertezaMedicao, IncertezaEstimativa, RuidoProcesso)
+KALMAN_ERRO_MEDICAO = 4.0
+KALMAN_ERRO_ESTIMATIVA = 2.0
+KALMAN_RUIDO_PROCESSO = 0.3
+KALMAN_RUIDO_ACELERACAO = 0.1  # cm/amostra² no período do treino
+
+# Filtro e termo D com que os ganhos foram treinados (o eva-pid usa o mesmo):
+#   "simples"    SimpleKalmanFilter + D pela diferença do erro (exp1..exp5)
+#   "velocidade" KalmanVelocidade + D pela velocidade do filtro (eva.ino atual)
+# O eva anota "# filtro=..." no log de convergência a cada boot, e vale a
+# última anotação antes da linha escolhida. Linhas sem anotação (logs mais
+# antigos que ela) usam FILTRO_TREINO; None = recusa.
+# Se informado e a anotação disser outra coisa, o gerador recusa.
+FILTRO_TREINO = "simples"  # exp5_de: firmware original, sem anotação
+
+# Calibração do sensor: cm = A * leitura^B - C, saturada em [DIST_MIN, DIST_MAX]
+CALIB_A = 10650.08
+CALIB_B = -0.935
+CALIB_C = 10
+DIST_MIN = 40
+DIST_MAX = 90
+
+
+def numerico(token):
+    try:
+        float(token)
+        return True
+    except ValueError:
+        return False
+
+
+def ler_melhor_linha(caminho):
+    # Colunas: Iteração/Geração, Gbest_Erro, Kp, Ki, Kd[, Diversidade, Decisao]
+    # Linhas que perderam a quebra (vários registros colados) são separadas
+    # pela largura, como no gerador_de_grafico.py. Cabeçalhos são pulados; o
+    # resto que não fecha é contado e avisado.
+    NUM_COLUNAS = 5
+    LARGURA_NOVA = 7
+
+    melhor = None
+    descartados = 0
+    filtro = None  # Da última anotação "# filtro=..."
+    with open(caminho, 'r') as f:
+        for numero, linha in enumerate(f, start=1):
+            if linha.startswith('#'):
+                for item in linha[1:].split():
+                    chave, _, valor = item.partition('=')
+                    if chave == 'filtro':
+                        filtro = valor
+                continue
+            tokens = [t.strip() for t in linha.split(',')]
+            while tokens and not tokens[-1]: tokens.pop() # Vírgula final da colagem
+            if not tokens or not numerico(tokens[0]):
+                continue
+
+            # Formato novo: a 7ª coluna (Decisao) nunca é número
+            if len(tokens) % LARGURA_NOVA == 0 and not any(
+                    numerico(tokens[i]) for i in range(LARGURA_NOVA - 1, len(tokens), LARGURA_NOVA)):
+                largura = LARGURA_NOVA
+            elif len(tokens) % NUM_COLUNAS == 0:
+                largura = NUM_COLUNAS
+            else:
+                descartados += 1
+                continue
+
+            for i in range(0, len(tokens), largura):
+                registro = tokens[i:i + NUM_COLUNAS]
+                if not all(numerico(t) for t in registro):
+                    descartados += 1
+                    continue
+                iteracao = int(float(registro[0]))
+                erro, kp, ki, kd = (float(t) for t in registro[1:])
+                if melhor is None or erro < melhor[1]:
+                    melhor = (iteracao, erro, kp, ki, kd, numero, filtro)
+
+    if descartados:
+        print(f"AVISO: {descartados} linha(s)/registro(s) mal formado(s) ignorado(s) em '{caminho}'.")
+    return melhor
+
+
+def medir_periodo_treino(caminho):
+    # Colunas: Iteração, Partícula, Distância, PWM, Erro, Gbest_Erro[, Passo]
+    # Uma rodada é uma sequência de linhas com o mesmo par (iteração,
+    # partícula); o maior Passo dela é o número de passadas em
+    # TEMPO_DE_EXECUCAO_MS (a última linha sai até ~90 ms antes do fim: <1%).
+    # Usa a mediana: rodadas cortadas por reboot não puxam o valor.
+    passadas = []
+    rodada, maior = None, 0
+    try:
+        with open(caminho, 'r') as f:
+            for linha in f:
+                tokens = [t.strip() for t in linha.split(',')]
+                if len(tokens) != 7 or not all(numerico(t) for t in tokens):
+                    continue
+                chave = (tokens[0], tokens[1])
+                if chave != rodada:
+                    if maior: passadas.append(maior)
+                    rodada, maior = chave, 0
+                maior = max(maior, int(float(tokens[6])))
+    except FileNotFoundError:
+        return None
+    if maior: passadas.append(maior)
+    if not passadas:
+        return None
+    passadas.sort()
+    mediana = passadas[len(passadas) // 2]
+    return TEMPO_DE_EXECUCAO_MS / mediana, len(passadas)
+
+
+def cm_da_leitura(leitura):
+    return CALIB_A * leitura ** CALIB_B - CALIB_C
+
+
+def gerar_tabela():
+    # cm decresce com a leitura: procura a última leitura ainda >= DIST_MAX
+    # e a primeira já <= DIST_MIN. Fora desse intervalo o valor é constante.
+    leitura_min = 1
+    while cm_da_leitura(leitura_min + 1) >= DIST_MAX:
+        leitura_min += 1
+    leitura_max = leitura_min
+    while cm_da_leitura(leitura_max) > DIST_MIN:
+        leitura_max += 1
+
+    tabela = []
+    for leitura in range(leitura_min, leitura_max + 1):
+        cm = cm_da_leitura(leitura)
+        tabela.append(min(max(cm, DIST_MIN), DIST_MAX))
+    return leitura_min, leitura_max, tabela
+
+
+def literal(valor):
+    texto = f'{valor:.7g}'
+    if '.' not in texto and 'e' not in texto:
+        texto += '.0'
+    return texto + 'f'
+
+
+def gerar_sintonia():
+    if not os.path.exists(ARQUIVO_ENTRADA):
+        print(f"ERRO: O arquivo '{ARQUIVO_ENTRADA}' não foi encontrado na pasta.")
+        sys.exit(1)
+
+    melhor = ler_melhor_linha(ARQUIVO_ENTRADA)
+    if melhor is None:
+        print(f"ERRO: Nenhuma linha válida em '{ARQUIVO_ENTRADA}'.")
+        sys.exit(1)
+
+    iteracao, erro, kp, ki, kd, numero, filtro = melhor
+
+    if filtro is None:
+        if FILTRO_TREINO is None:
+            print(f"ERRO: a linha {numero} de '{ARQUIVO_ENTRADA}' não tem anotação de filtro.")
+            print("Informe FILTRO_TREINO com o filtro do firmware que gravou esse log.")
+            sys.exit(1)
+        filtro = FILTRO_TREINO
+        origem_filtro = "FILTRO_TREINO, log sem anotação"
+    elif FILTRO_TREINO is not None and FILTRO_TREINO != filtro:
+        print(f"ERRO: FILTRO_TREINO = \"{FILTRO_TREINO}\", mas a linha {numero} de '{ARQUIVO_ENTRADA}' foi treinada com filtro \"{filtro}\".")
+        print("Os ganhos só valem com o filtro e o termo D do treino.")
+        sys.exit(1)
+    else:
+        origem_filtro = "anotação do log"
+    if filtro not in ("simples", "velocidade"):
+        print(f"ERRO: filtro \"{filtro}\" desconhecido (esperado \"simples\" ou \"velocidade\").")
+        sys.exit(1)
+
+    periodo = medir_periodo_treino(ARQUIVO_DADOS)
+    if periodo is not None:
+        periodo_treino, rodadas = periodo
+        origem_periodo = f"mediana da coluna Passo em {rodadas} rodadas de {os.path.basename(ARQUIVO_DADOS)}"
+    else:
+        periodo_treino = PERIODO_TREINO_MS_SEM_PASSO
+        origem_periodo = "PERIODO_TREINO_MS_SEM_PASSO: log sem a coluna Passo"
+        print(f"AVISO: '{ARQUIVO_DADOS}' não tem a coluna Passo; usando {periodo_treino} ms por amostra no treino.")
+
+    escala = PERIODO_CONTROLE_MS / periodo_treino
+    ki_d = ki * escala
+    kd_d = kd / escala
+    limite_integral = LIMITE_INTEGRAL_TREINO / escala
+    # Aceleração por amostra² escala com o quadrado do período
+    ruido_aceleracao = KALMAN_RUIDO_ACELERACAO * escala * escala
+
+    leitura_min, leitura_max, tabela = gerar_tabela()
+
+    linhas_tabela = []
+    for i in range(0, len(tabela), 8):
+        linhas_tabela.append('    ' + ', '.join(literal(v) for v in tabela[i:i + 8]) + ',')
+
+    conteudo = f"""// GERADO POR Ferramentas/gerador_sintonia.py -- NÃO EDITE À MÃO.
+// Origem: {os.path.relpath(ARQUIVO_ENTRADA, PASTA_FERRAMENTAS)} (linha {numero}, iteração {iteracao}, Gbest_Erro {erro})
+// Ganhos do treino: Kp={kp} Ki={ki} Kd={kd} a {periodo_treino:.2f} ms por amostra
+// ({origem_periodo}).
+#ifndef SINTONIA_H
+#define SINTONIA_H
+
+#include <EvaNucleo.h>
+
+// Filtro do treino: 1 = KalmanVelocidade com D pela velocidade,
+// 0 = SimpleKalmanFilter com D pela diferença do erro
+// (aqui: {filtro}, de {origem_filtro})
+#define SINTONIA_FILTRO_VELOCIDADE {1 if filtro == "velocidade" else 0}
+
+// Período do laço de controle
+#define PERIODO_CONTROLE_US {int(PERIODO_CONTROLE_MS * 1000)}UL
+
+// Ganhos discretos, já reescalados para PERIODO_CONTROLE_US
+struct Sintonia {{
+    static constexpr float kp() {{ return {literal(kp)}; }}
+    static constexpr float ki() {{ return {literal(ki_d)}; }}
+    static constexpr float kd() {{ return {literal(kd_d)}; }}
+    static constexpr float limiteIntegral() {{ return {literal(limite_integral)}; }}
+}};
+
+// (IncertezaMedicao, IncertezaEstimativa, RuidoProcesso)
+struct CoefKalmanSintonia {{
+    static constexpr float erroMedicao()    {{ return {literal(KALMAN_ERRO_MEDICAO)}; }}
+    static constexpr float erroEstimativa() {{ return {literal(KALMAN_ERRO_ESTIMATIVA)}; }}
+    static constexpr float ruidoProcesso()  {{ return {literal(KALMAN_RUIDO_PROCESSO)}; }}
+    static constexpr float ruidoAceleracao() {{ return {literal(ruido_aceleracao)}; }}
+}};
+
+// cm = {CALIB_A} * leitura^{CALIB_B} - {CALIB_C}, saturado em [{DIST_MIN}, {DIST_MAX}]
+#define LEITURA_TABELA_MIN {leitura_min}
+#define LEITURA_TABELA_MAX {leitura_max}
+const float TABELA_CM[] PROGMEM = {{
+{chr(10).join(linhas_tabela)}
+}};
+
+typedef CalibracaoTabela<LEITURA_TABELA_MIN, LEITURA_TABELA_MAX, TABELA_CM> CalibracaoSintonia;
+
+#endif
+"""
+
+    with open(ARQUIVO_SAIDA, 'w') as f:
+        f.write(conteudo)
+
+    print("-" * 30)
+    print(f"SUCESSO!")
+    print(f"1. Melhor linha: iteração {iteracao}, erro {erro} (Kp={kp}, Ki={ki}, Kd={kd})")
+    print(f"2. Ganhos a {PERIODO_CONTROLE_MS} ms: Kp={kp:.4f}, Ki={ki_d:.4f}, Kd={kd_d:.4f}")
+    print(f"   Período do treino: {periodo_treino:.2f} ms ({origem_periodo})")
+    print(f"   Filtro do treino: {filtro} ({origem_filtro})")
+    print(f"3. Tabela do sensor: leituras {leitura_min}..{leitura_max} ({len(tabela)} valores)")
+    print(f"4. Cabeçalho salvo em: {os.path.normpath(ARQUIVO_SAIDA)}")
+    print("-" * 30)
+
+
+if __name__ == "__main__":
+    gerar_sintonia()